@@ -41,6 +41,8 @@ T *furn_at( const tripoint_abs_ms &p )
         return nullptr;
     }
 
+    // The caller may modify it, possibly outside of the reality bubble.
+    sm->dirty = true;
     return dynamic_cast<T *>( &*iter->second );
 }
 
@@ -169,7 +171,9 @@ void battery_tile::update_internal( time_point, const tripoint_abs_ms &, distrib
 
 active_tile_data *battery_tile::clone() const
 {
-    return new battery_tile( *this );
+    battery_tile *copy = new battery_tile( *this );
+    copy->grid_stored.reset();
+    return copy;
 }
 
 const std::string &battery_tile::get_type() const
@@ -196,18 +200,25 @@ int battery_tile::get_resource() const
 
 int battery_tile::mod_resource( int amt )
 {
+    const int stored_before = stored;
+    int excess = 0;
     // TODO: Avoid int64 math if possible
     std::int64_t sum = static_cast<std::int64_t>( stored ) + amt;
     if( sum >= max_stored ) {
         stored = max_stored;
-        return sum - max_stored;
+        excess = sum - max_stored;
     } else if( sum <= 0 ) {
         stored = 0;
-        return sum - stored;
+        excess = sum - stored;
     } else {
         stored = sum;
-        return 0;
     }
+    if( const shared_ptr_fast<int> grid_total = grid_stored.lock() ) {
+        *grid_total += stored - stored_before;
+    }
+    // Grid power can be crafted with
+    map::resource_changes++;
+    return excess;
 }
 
 void charge_watcher_tile::update_internal( time_point /*to*/, const tripoint_abs_ms &p,
@@ -254,6 +265,7 @@ void charger_tile::update_internal( time_point to, const tripoint_abs_ms &p,
     if( sm == nullptr ) {
         return;
     }
+    sm->dirty = true;
     std::int64_t power = this->power * to_seconds<std::int64_t>( to - get_last_updated() );
     // TODO: Make not a copy from map.cpp
     for( item &outer : sm->get_items( p_within_sm.raw() ) ) {
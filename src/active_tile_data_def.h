@@ -3,6 +3,7 @@
 #define CATA_SRC_ACTIVE_TILE_DATA_DEF_H
 
 #include "active_tile_data.h"
+#include "memory_fast.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -32,6 +33,12 @@ class battery_tile : public active_tile_data
 
         int get_resource() const;
         int mod_resource( int amt );
+
+        /**
+         * Total charge of the batteries of the grid this battery is part of, kept up to date by
+         * @ref mod_resource. Set by the grid, and not copied along with the battery.
+         */
+        weak_ptr_fast<int> grid_stored;
 };
 
 class charge_watcher_tile : public active_tile_data
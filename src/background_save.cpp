@@ -0,0 +1,167 @@
+#include "background_save.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "output.h"
+#include "translations.h"
+
+#define dbg(x) DebugLogFL((x),DC::Main)
+
+namespace background_save
+{
+
+namespace
+{
+
+struct pending_file {
+    std::string path;
+    std::string contents;
+    /** Copied, as it may come from a translation buffer that doesn't live long enough. */
+    std::string fail_message;
+    std::string error;
+};
+
+/**
+ * The files of one batch. Once the worker has started, the main thread only reads
+ * @ref paths and @ref done until it has joined the worker.
+ */
+struct job {
+    std::vector<pending_file> files;
+    std::vector<std::string> removals;
+    std::unordered_set<std::string> paths;
+    std::atomic<bool> done{ false };
+    std::thread worker;
+
+    void run() {
+        for( pending_file &file : files ) {
+            try {
+                // Not write_to_file, that would wait for this very job.
+                ofstream_wrapper fout( file.path, cata_ios_mode::binary );
+                fout.stream().write( file.contents.data(), file.contents.size() );
+                fout.close();
+            } catch( const std::exception &err ) {
+                file.error = err.what();
+            }
+            // No need to keep it around anymore.
+            std::string().swap( file.contents );
+        }
+        for( const std::string &path : removals ) {
+            if( file_exist( path ) ) {
+                remove_file( path );
+            }
+        }
+        done = true;
+    }
+
+    ~job() {
+        if( worker.joinable() ) {
+            worker.join();
+        }
+    }
+};
+
+std::unique_ptr<job> collecting_job;
+std::unique_ptr<job> running_job;
+
+void finish_running_job()
+{
+    if( !running_job ) {
+        return;
+    }
+    if( running_job->worker.joinable() ) {
+        running_job->worker.join();
+    }
+    const std::unique_ptr<job> finished = std::move( running_job );
+    for( const pending_file &file : finished->files ) {
+        if( file.error.empty() ) {
+            continue;
+        }
+        if( !file.fail_message.empty() ) {
+            popup( _( "Failed to write %1$s to \"%2$s\": %3$s" ), file.fail_message, file.path,
+                   file.error );
+        } else {
+            popup( _( "Failed to write \"%1$s\": %2$s" ), file.path, file.error );
+        }
+    }
+}
+
+} // namespace
+
+batch::batch()
+{
+    wait();
+    collecting_job = std::make_unique<job>();
+}
+
+batch::~batch()
+{
+    running_job = std::move( collecting_job );
+    try {
+        running_job->worker = std::thread( &job::run, running_job.get() );
+    } catch( const std::system_error &err ) {
+        dbg( DL::Error ) << "Failed to create save thread, saving in the foreground: " << err.what();
+        running_job->run();
+        finish_running_job();
+    }
+}
+
+bool collecting()
+{
+    return collecting_job != nullptr;
+}
+
+void add( const std::string &path, std::string contents, const char *fail_message )
+{
+    collecting_job->paths.insert( path );
+    collecting_job->files.push_back( { path, std::move( contents ),
+                                       fail_message ? fail_message : "", std::string() } );
+}
+
+void remove( const std::string &path )
+{
+    if( collecting() ) {
+        collecting_job->paths.insert( path );
+        collecting_job->removals.push_back( path );
+        return;
+    }
+    wait_for( path );
+    if( file_exist( path ) ) {
+        remove_file( path );
+    }
+}
+
+void wait()
+{
+    finish_running_job();
+}
+
+void wait_for( const std::string &path )
+{
+    if( running_job && running_job->paths.count( path ) ) {
+        finish_running_job();
+    }
+}
+
+void poll()
+{
+    if( running_job && running_job->done ) {
+        finish_running_job();
+    }
+}
+
+} // namespace background_save
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CATA_SRC_BACKGROUND_SAVE_H
+#define CATA_SRC_BACKGROUND_SAVE_H
+
+#include <string>
+
+/**
+ * Lets a save serialize everything on the main thread, and leaves writing the files to a worker
+ * thread, so the game can go on in the meantime.
+ *
+ * While a @ref background_save::batch exists, @ref write_to_file on the main thread only
+ * serializes into memory. Once the batch is destroyed, a worker thread writes all of it out.
+ * Reading or writing any of those files on the main thread before the worker is done with them
+ * waits for it first, so nobody sees an outdated file.
+ */
+namespace background_save
+{
+
+class batch
+{
+    public:
+        /** Waits for the files of an earlier batch to be written first. */
+        batch();
+        /** Hands the collected files to the worker thread. */
+        ~batch();
+
+        batch( const batch & ) = delete;
+        batch &operator=( const batch & ) = delete;
+};
+
+/** Whether a @ref batch is collecting files right now. */
+bool collecting();
+/**
+ * Adds a serialized file to the current batch.
+ * @param fail_message Describes the file if writing it fails, see @ref write_to_file.
+ */
+void add( const std::string &path, std::string contents, const char *fail_message );
+/** Removes the file, once the current batch has been written if there is one, otherwise now. */
+void remove( const std::string &path );
+
+/** Waits until the worker thread is done, and reports anything it failed to write. */
+void wait();
+/** Waits for the worker thread if it is going to write or remove the file. */
+void wait_for( const std::string &path );
+/** Reports anything the worker thread failed to write if it is done. Never blocks. */
+void poll();
+
+} // namespace background_save
+
+#endif // CATA_SRC_BACKGROUND_SAVE_H
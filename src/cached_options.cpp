@@ -12,6 +12,7 @@ int message_cooldown;
 bool trigdist;
 bool fov_3d;
 int fov_3d_z_range;
+bool monster_fov_bitmaps;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
@@ -61,6 +61,12 @@ extern bool fov_3d;
 /** 3D FoV range, in Z levels, in both directions. */
 extern int fov_3d_z_range;
 
+/**
+ * Monsters look up what they can see in a field of view shadowcast from their tile,
+ * instead of tracing a line to every target. See @ref map::sees_with_fov.
+ */
+extern bool monster_fov_bitmaps;
+
 /** Using isometric tileset. */
 extern bool tile_iso;
 
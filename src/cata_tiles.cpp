@@ -319,6 +319,9 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force )
 {
+    // Also called once the game data is loaded, where the ids may have changed.
+    terrain_lookup_cache.clear();
+    furniture_lookup_cache.clear();
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -1771,6 +1774,20 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     }
 }
 
+cata::optional<tile_lookup_res> cata_tiles::find_tile_looks_like( const ter_id &id ) const
+{
+    return terrain_lookup_cache.get( season_of_year( calendar::turn ), id.to_i(), [&]() {
+        return find_tile_looks_like( id.id().str(), C_TERRAIN );
+    } );
+}
+
+cata::optional<tile_lookup_res> cata_tiles::find_tile_looks_like( const furn_id &id ) const
+{
+    return furniture_lookup_cache.get( season_of_year( calendar::turn ), id.to_i(), [&]() {
+        return find_tile_looks_like( id.id().str(), C_FURNITURE );
+    } );
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         std::string &draw_id )
 {
@@ -1813,25 +1830,41 @@ bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &ov
     return exists;
 }
 
+bool cata_tiles::in_screen_bounds( const tripoint &pos ) const
+{
+    // check to make sure that we are drawing within a valid area
+    // [0->width|height / tile_width|height]
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    return tile_iso || screen_bounds.contains( pos.xy() );
+}
+
 bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                       const std::string &subcategory, const tripoint &pos,
                                       int subtile, int rota, lit_level ll,
                                       bool apply_night_vision_goggles, int &height_3d )
+{
+    // Don't walk the looks_like chain for tiles that won't be drawn anyway.
+    if( !in_screen_bounds( pos ) ) {
+        return false;
+    }
+    return draw_from_tile_lookup( id, find_tile_looks_like( id, category ), category, subcategory,
+                                  pos, subtile, rota, ll, apply_night_vision_goggles, height_3d );
+}
+
+bool cata_tiles::draw_from_tile_lookup( const std::string &id,
+                                        cata::optional<tile_lookup_res> res, TILE_CATEGORY category,
+                                        const std::string &subcategory, const tripoint &pos,
+                                        int subtile, int rota, lit_level ll,
+                                        bool apply_night_vision_goggles, int &height_3d )
 {
     // If the ID string does not produce a drawable tile
     // it will revert to the "unknown" tile.
     // The "unknown" tile is one that is highly visible so you kinda can't miss it :D
 
-    // check to make sure that we are drawing within a valid area
-    // [0->width|height / tile_width|height]
-
-    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
-    if( !tile_iso &&
-        !screen_bounds.contains( pos.xy() ) ) {
+    if( !in_screen_bounds( pos ) ) {
         return false;
     }
 
-    cata::optional<tile_lookup_res> res = find_tile_looks_like( id, category );
     const tile_type *tt = nullptr;
     if( res ) {
         tt = &( res->tile() );
@@ -2475,8 +2508,9 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         }
         // draw the actual terrain if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_tile_lookup( tname, find_tile_looks_like( t ), C_TERRAIN,
+                                          empty_string, p, subtile, rotation, ll,
+                                          nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2498,13 +2532,13 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d );
+            return draw_from_tile_lookup( tname, find_tile_looks_like( t2 ), C_TERRAIN,
+                                          empty_string, p, subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_terrain_memory_at( p );
-        return draw_from_id_string( t.tile, C_TERRAIN, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_TERRAIN, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -2514,7 +2548,7 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        return !t.tile.empty();
+        return !t.tile().empty();
     }
     return false;
 }
@@ -2523,7 +2557,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "t_" ) ) {
+        if( string_starts_with( t.tile(), "t_" ) ) {
             return true;
         }
     }
@@ -2534,7 +2568,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "f_" ) ) {
+        if( string_starts_with( t.tile(), "f_" ) ) {
             return true;
         }
     }
@@ -2545,7 +2579,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "tr_" ) ) {
+        if( string_starts_with( t.tile(), "tr_" ) ) {
             return true;
         }
     }
@@ -2556,7 +2590,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "vp_" ) ) {
+        if( string_starts_with( t.tile(), "vp_" ) ) {
             return true;
         }
     }
@@ -2567,7 +2601,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "t_" ) ) {
+        if( string_starts_with( t.tile(), "t_" ) ) {
             return t;
         }
     }
@@ -2578,7 +2612,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "f_" ) ) {
+        if( string_starts_with( t.tile(), "f_" ) ) {
             return t;
         }
     }
@@ -2589,7 +2623,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "tr_" ) ) {
+        if( string_starts_with( t.tile(), "tr_" ) ) {
             return t;
         }
     }
@@ -2600,7 +2634,7 @@ memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) cons
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( string_starts_with( t.tile, "vp_" ) ) {
+        if( string_starts_with( t.tile(), "vp_" ) ) {
             return t;
         }
     }
@@ -2640,8 +2674,9 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_tile_lookup( fname, find_tile_looks_like( f ), C_FURNITURE,
+                                          empty_string, p, subtile, rotation, ll,
+                                          nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2669,13 +2704,13 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d );
+            return draw_from_tile_lookup( fname, find_tile_looks_like( f2 ), C_FURNITURE,
+                                          empty_string, p, subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_furniture_memory_at( p );
-        return draw_from_id_string( t.tile, C_FURNITURE, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_FURNITURE, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -2750,7 +2785,7 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_trap_memory_at( p );
-        return draw_from_id_string( t.tile, C_TRAP, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_TRAP, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -2915,7 +2950,7 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
     } else if( invisible[0] && has_vpart_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_vpart_memory_at( p );
-        return draw_from_id_string( t.tile, C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d );
     }
     return false;
@@ -22,6 +22,7 @@
 #include "point.h"
 #include "sdl_wrappers.h"
 #include "sdl_geometry.h"
+#include "tile_lookup_cache.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -368,6 +369,14 @@ class cata_tiles
         find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEGORY category,
                                            int looks_like_jumps_limit ) const;
 
+        /**
+         * Same as find_tile_looks_like, for terrain and furniture. The results are kept in
+         * @ref terrain_lookup_cache and @ref furniture_lookup_cache, so the draw loop doesn't
+         * repeat the string lookups.
+         */
+        cata::optional<tile_lookup_res> find_tile_looks_like( const ter_id &id ) const;
+        cata::optional<tile_lookup_res> find_tile_looks_like( const furn_id &id ) const;
+
 
         bool find_overlay_looks_like( bool male, const std::string &overlay, std::string &draw_id );
 
@@ -381,6 +390,13 @@ class cata_tiles
         bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /** Whether @p pos is on the screen. Always true for isometric tilesets. */
+        bool in_screen_bounds( const tripoint &pos ) const;
+        /** Same as draw_from_id_string, with the tile for @p id already looked up into @p res. */
+        bool draw_from_tile_lookup( const std::string &id, cata::optional<tile_lookup_res> res,
+                                    TILE_CATEGORY category, const std::string &subcategory,
+                                    const tripoint &pos, int subtile, int rota, lit_level ll,
+                                    bool apply_night_vision_goggles, int &height_3d );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -588,6 +604,13 @@ class cata_tiles
         const GeometryRenderer_Ptr &geometry;
         std::unique_ptr<tileset> tileset_ptr;
 
+        /**
+         * Terrain and furniture tiles found so far, by int_id. Cleared whenever a tileset is
+         * loaded, which also happens after the game data is loaded.
+         */
+        mutable tile_lookup_cache<cata::optional<tile_lookup_res>> terrain_lookup_cache;
+        mutable tile_lookup_cache<cata::optional<tile_lookup_res>> furniture_lookup_cache;
+
         int tile_height = 0;
         int tile_width = 0;
         // The width and height of the area we can draw in,
@@ -12,6 +12,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "background_save.h"
 #include "debug.h"
 #include "filesystem.h"
 #include "json.h"
@@ -450,19 +451,33 @@ std::istream *cata_ifstream::operator->()
     return &*_stream;
 }
 
-void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+static void write_or_collect( const std::string &path,
+                              const std::function<void( std::ostream & )> &writer,
+                              const char *const fail_message )
 {
+    if( background_save::collecting() ) {
+        std::ostringstream buffer;
+        writer( buffer );
+        background_save::add( path, buffer.str(), fail_message );
+        return;
+    }
+    background_save::wait_for( path );
     // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
     ofstream_wrapper fout( path, cata_ios_mode::binary );
     writer( fout.stream() );
     fout.close();
 }
 
+void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+{
+    write_or_collect( path, writer, nullptr );
+}
+
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
                     const char *const fail_message )
 {
     try {
-        write_to_file( path, writer );
+        write_or_collect( path, writer, fail_message );
         return true;
 
     } catch( const std::exception &err ) {
@@ -518,6 +533,7 @@ std::istream &safe_getline( std::istream &ins, std::string &str )
 
 bool read_from_file( const std::string &path, const std::function<void( std::istream & )> &reader )
 {
+    background_save::wait_for( path );
     try {
         cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( path ) );
         if( !fin.is_open() ) {
@@ -556,6 +572,7 @@ bool read_from_file_optional( const std::string &path,
     // Note: slight race condition here, but we'll ignore it. Worst case: the file
     // exists and got removed before reading it -> reading fails with a message
     // Or file does not exists, than everything works fine because it's optional anyway.
+    background_save::wait_for( path );
     return file_exist( path ) && read_from_file( path, reader );
 }
 
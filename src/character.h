@@ -2197,6 +2197,16 @@ class Character : public Creature, public visitable<Character>
         int cached_moves = 0;
         tripoint cached_position;
         inventory cached_crafting_inventory;
+        /**
+         * The part of @ref cached_crafting_inventory formed from the map. It is kept for the
+         * rest of the turn while nothing it is made of changes, see @ref map::resource_changes.
+         */
+        inventory cached_map_inventory;
+        tripoint cached_map_position = tripoint_min;
+        int cached_map_radius = 0;
+        bool cached_map_clear_path = false;
+        time_point cached_map_time;
+        std::uint64_t cached_map_changes = 0;
 
     protected:
         // a cache of all active enchantment values.
@@ -568,7 +568,21 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
         && cached_position == inv_pos ) {
         return cached_crafting_inventory;
     }
-    cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
+    if( cached_map_time != calendar::turn
+        || cached_map_position != inv_pos
+        || cached_map_radius != radius
+        || cached_map_clear_path != clear_path
+        || cached_map_changes != map::resource_changes ) {
+        cached_map_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
+        cached_map_time = calendar::turn;
+        cached_map_position = inv_pos;
+        cached_map_radius = radius;
+        cached_map_clear_path = clear_path;
+        cached_map_changes = map::resource_changes;
+    }
+    cached_crafting_inventory = cached_map_inventory;
+    // The copied caches still point into the map inventory.
+    cached_crafting_inventory.unsort();
     cached_crafting_inventory += inv;
     cached_crafting_inventory += weapon;
     cached_crafting_inventory += worn;
@@ -597,6 +611,7 @@ void Character::invalidate_crafting_inventory()
 {
     cached_time = calendar::before_time_starts;
     cached_position = tripoint_min;
+    cached_map_position = tripoint_min;
 }
 
 void player::make_craft( const recipe_id &id_to_make, int batch_size, const tripoint &loc )
@@ -309,6 +309,8 @@ bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
             int adj_range = std::floor( range * player_visibility_factor );
             return adj_range >= wanted_range &&
                    here.get_cache_ref( pos().z ).seen_cache[pos().x][pos().y] > LIGHT_TRANSPARENCY_SOLID;
+        } else if( monster_fov_bitmaps && t.z == posz() && is_monster() ) {
+            return here.sees_with_fov( pos(), t, range );
         } else {
             return here.sees( pos(), t, range );
         }
@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -16,6 +18,8 @@
 
 #define dbg(x) DebugLogFL((x),DC::Game)
 
+static const mfaction_str_id monfaction_player( "player" );
+
 Creature_tracker::Creature_tracker() = default;
 
 Creature_tracker::~Creature_tracker() = default;
@@ -86,7 +90,7 @@ bool Creature_tracker::add( shared_ptr_fast<monster> critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    add_to_location_map( critter_ptr, critter.pos() );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -100,8 +104,7 @@ void Creature_tracker::add_to_faction_map( shared_ptr_fast<monster> critter_ptr
     if( critter.friendly == 0 ) {
         monster_faction_map_[ critter.faction ].insert( critter_ptr );
     } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
+        monster_faction_map_[ monfaction_player ].insert( critter_ptr );
     }
 }
 
@@ -137,7 +140,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     } );
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        add_to_location_map( *iter, new_pos );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -152,8 +155,108 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     }
 }
 
+void Creature_tracker::add_to_location_map( const shared_ptr_fast<monster> &critter,
+        const tripoint &pos )
+{
+    monsters_by_location[pos] = critter;
+    add_to_cell( *critter, pos );
+}
+
+void Creature_tracker::add_to_cell( monster &critter, const tripoint &pos )
+{
+    remove_from_cell( critter );
+    const mfaction_id faction = critter.friendly == 0 ? critter.faction : monfaction_player.id();
+    const tripoint cell = divide_xy_round_to_minus_infinity( pos, SEEX );
+    monsters_by_cell[faction][cell].push_back( &critter );
+    cell_of[&critter] = std::make_pair( faction, cell );
+}
+
+void Creature_tracker::remove_from_cell( const monster &critter )
+{
+    const auto iter = cell_of.find( &critter );
+    if( iter == cell_of.end() ) {
+        return;
+    }
+    cell_map &cells = monsters_by_cell[iter->second.first];
+    const auto cell_iter = cells.find( iter->second.second );
+    if( cell_iter != cells.end() ) {
+        std::vector<monster *> &cell = cell_iter->second;
+        cell.erase( std::remove( cell.begin(), cell.end(), &critter ), cell.end() );
+        if( cell.empty() ) {
+            cells.erase( cell_iter );
+        }
+    }
+    cell_of.erase( iter );
+}
+
+void Creature_tracker::find_in_cells( const cell_map &cells, const tripoint &center,
+                                      const int radius, const std::function<bool( const monster & )> &filter,
+                                      std::vector<monster *> &result ) const
+{
+    tripoint lo = divide_xy_round_to_minus_infinity( center - tripoint( radius, radius, 0 ), SEEX );
+    tripoint hi = divide_xy_round_to_minus_infinity( center + tripoint( radius, radius, 0 ), SEEX );
+    lo.z = std::max( center.z - radius, -OVERMAP_DEPTH );
+    hi.z = std::min( center.z + radius, OVERMAP_HEIGHT );
+    if( lo.z > hi.z ) {
+        return;
+    }
+
+    const auto add_from = [&]( const std::vector<monster *> &cell ) {
+        for( monster *critter : cell ) {
+            if( !critter->is_dead() && square_dist( center, critter->pos() ) <= radius &&
+                ( !filter || filter( *critter ) ) ) {
+                result.push_back( critter );
+            }
+        }
+    };
+    // Large areas are more quickly searched by going over the occupied cells
+    const size_t area = static_cast<size_t>( hi.x - lo.x + 1 ) * ( hi.y - lo.y + 1 ) *
+                        ( hi.z - lo.z + 1 );
+    if( cells.size() <= area ) {
+        for( const auto &cell : cells ) {
+            const tripoint &p = cell.first;
+            if( p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y && p.z >= lo.z && p.z <= hi.z ) {
+                add_from( cell.second );
+            }
+        }
+        return;
+    }
+    for( int z = lo.z; z <= hi.z; z++ ) {
+        for( int x = lo.x; x <= hi.x; x++ ) {
+            for( int y = lo.y; y <= hi.y; y++ ) {
+                const auto iter = cells.find( tripoint( x, y, z ) );
+                if( iter != cells.end() ) {
+                    add_from( iter->second );
+                }
+            }
+        }
+    }
+}
+
+std::vector<monster *> Creature_tracker::monsters_within( const tripoint &center, const int radius,
+        const std::function<bool( const monster & )> &filter ) const
+{
+    std::vector<monster *> result;
+    for( const auto &faction_cells : monsters_by_cell ) {
+        find_in_cells( faction_cells.second, center, radius, filter, result );
+    }
+    return result;
+}
+
+std::vector<monster *> Creature_tracker::monsters_within( const tripoint &center, const int radius,
+        const mfaction_id &faction, const std::function<bool( const monster & )> &filter ) const
+{
+    std::vector<monster *> result;
+    const auto iter = monsters_by_cell.find( faction );
+    if( iter != monsters_by_cell.end() ) {
+        find_in_cells( iter->second, center, radius, filter, result );
+    }
+    return result;
+}
+
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
+    remove_from_cell( critter );
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
         monsters_by_location.erase( pos_iter );
@@ -200,6 +303,8 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_cell.clear();
+    cell_of.clear();
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -207,9 +312,11 @@ void Creature_tracker::clear()
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_cell.clear();
+    cell_of.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        add_to_location_map( mon_ptr, mon_ptr->pos() );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -244,10 +351,14 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        add_to_location_map( first_ptr, first.pos() );
+    } else {
+        remove_from_cell( first );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        add_to_location_map( second_ptr, second.pos() );
+    } else {
+        remove_from_cell( second );
     }
 }
 
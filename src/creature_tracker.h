@@ -3,9 +3,11 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "memory_fast.h"
@@ -91,11 +93,39 @@ class Creature_tracker
             return monster_faction_map_;
         }
 
+        /**
+         * Living monsters at most `radius` tiles away from `center` along each axis (z included),
+         * for which `filter` returns true, if given.
+         */
+        std::vector<monster *> monsters_within( const tripoint &center, int radius,
+                                                const std::function<bool( const monster & )> &filter = nullptr ) const;
+        /** Same as above, but only monsters in the given entry of @ref factions. */
+        std::vector<monster *> monsters_within( const tripoint &center, int radius,
+                                                const mfaction_id &faction,
+                                                const std::function<bool( const monster & )> &filter = nullptr ) const;
+
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+
+        using cell_map = std::unordered_map<tripoint, std::vector<monster *>>;
+        /**
+         * Monsters in @ref monsters_by_location, bucketed by faction (the same way as in
+         * @ref monster_faction_map_) and then by the submap sized cell they're in.
+         */
+        std::unordered_map<mfaction_id, cell_map> monsters_by_cell;
+        /** Faction and cell each monster in @ref monsters_by_cell was filed under. */
+        std::unordered_map<const monster *, std::pair<mfaction_id, tripoint>> cell_of;
+
+        /** Sets the monster at pos in @ref monsters_by_location and files it in its cell. */
+        void add_to_location_map( const shared_ptr_fast<monster> &critter, const tripoint &pos );
+        void remove_from_cell( const monster &critter );
+        void add_to_cell( monster &critter, const tripoint &pos );
+        void find_in_cells( const cell_map &cells, const tripoint &center, int radius,
+                            const std::function<bool( const monster & )> &filter,
+                            std::vector<monster *> &result ) const;
 };
 
 #endif // CATA_SRC_CREATURE_TRACKER_H
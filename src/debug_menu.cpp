@@ -43,6 +43,7 @@
 #include "enums.h"
 #include "faction.h"
 #include "filesystem.h"
+#include "fstream_utils.h"
 #include "game.h"
 #include "game_constants.h"
 #include "game_inventory.h"
@@ -75,6 +76,7 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -90,6 +92,7 @@
 #include "string_utils.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -177,6 +180,7 @@ enum debug_menu_index {
     DEBUG_TEST_MAP_EXTRA_DISTRIBUTION,
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_HOUR_TIMER,
+    DEBUG_TURN_PROFILER,
     DEBUG_NESTED_MAPGEN
 };
 
@@ -224,6 +228,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER, true, 'P', _( "Turn profiler…" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -1259,6 +1264,46 @@ void mission_debug::edit_mission( mission &m )
     }
 }
 
+static void turn_profiler_menu()
+{
+    enum {
+        TOGGLE, SHOW, EXPORT
+    };
+    const int choice = uilist( _( "Turn profiler" ), {
+        uilist_entry( TOGGLE, true, 't',
+                      turn_profiler::enabled() ? _( "Disable" ) : _( "Enable" ) ),
+        uilist_entry( SHOW, true, 's', _( "Show phase timings" ) ),
+        uilist_entry( EXPORT, true, 'e', _( "Export Chrome trace" ) )
+    } );
+    switch( choice ) {
+        case TOGGLE:
+            turn_profiler::set_enabled( !turn_profiler::enabled() );
+            add_msg( m_info, turn_profiler::enabled() ? _( "Turn profiler enabled." ) :
+                     _( "Turn profiler disabled." ) );
+            break;
+        case SHOW: {
+            const auto new_win = []() {
+                const point origin( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                    std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) );
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH, origin );
+            };
+            scrollable_text( new_win, _( "Turn profiler" ), turn_profiler::format_stats() );
+            break;
+        }
+        case EXPORT: {
+            const std::string path = PATH_INFO::config_dir() + "turn_trace.json";
+            if( write_to_file( path, []( std::ostream & fout ) {
+            turn_profiler::write_chrome_trace( fout );
+            }, _( "turn profiler trace" ) ) ) {
+                popup( _( "Trace written to %s" ), path );
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 void benchmark( const int max_difference, bench_kind kind )
 {
     std::string bench_name;
@@ -1754,6 +1799,9 @@ void debug()
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case DEBUG_TURN_PROFILER:
+            turn_profiler_menu();
+            break;
         case DEBUG_CHANGE_TIME: {
             auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
                 const auto text = string_input_popup()
@@ -19,6 +19,7 @@ static distribution_grid empty_grid( {}, MAPBUFFER );
 distribution_grid::distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords,
                                       mapbuffer &buffer ) :
     submap_coords( global_submap_coords ),
+    stored_here( make_shared_fast<int>( 0 ) ),
     mb( buffer )
 {
     for( const tripoint_abs_sm &sm_coord : submap_coords ) {
@@ -32,6 +33,15 @@ distribution_grid::distribution_grid( const std::vector<tripoint_abs_sm> &global
             const tripoint_abs_ms abs_pos = project_combine( sm_coord, active.first );
             contents[sm_coord].emplace_back( active.first, abs_pos );
             flat_contents.emplace_back( abs_pos );
+            active_tile_data *data = active.second.get();
+            if( battery_tile *battery = dynamic_cast<battery_tile *>( data ) ) {
+                batteries.emplace_back( active.first, abs_pos );
+                battery->grid_stored = stored_here;
+                *stored_here += battery->stored;
+                capacity_here += battery->max_stored;
+            } else if( dynamic_cast<const vehicle_connector_tile *>( data ) ) {
+                connectors.emplace_back( active.first, abs_pos );
+            }
         }
     }
 }
@@ -53,6 +63,7 @@ void distribution_grid::update( time_point to )
         if( sm == nullptr ) {
             return;
         }
+        sm->dirty = true;
 
         for( const tile_location &loc : c.second ) {
             auto &active = sm->active_furniture[loc.on_submap];
@@ -69,49 +80,61 @@ void distribution_grid::update( time_point to )
 // TODO: Shouldn't be here
 #include "vehicle.h"
 static itype_id itype_battery( "battery" );
-int distribution_grid::mod_resource( int amt, bool recurse )
+std::vector<vehicle *> distribution_grid::connected_vehicles() const
 {
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                int amt_before_battery = amt;
-                amt = battery->mod_resource( amt );
-                if( cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + amt_before_battery - amt;
-                }
-                if( amt == 0 ) {
-                    return 0;
-                }
+    std::vector<vehicle *> result;
+    for( const tile_location &loc : connectors ) {
+        const vehicle_connector_tile *connector =
+            active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
+        if( connector == nullptr ) {
+            continue;
+        }
+        for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
+            vehicle *veh = vehicle::find_vehicle( veh_abs );
+            if( veh == nullptr ) {
+                // TODO: Disconnect
+                debugmsg( "lost vehicle at %s", veh_abs.to_string() );
                 continue;
             }
+            result.push_back( veh );
+        }
+    }
+    return result;
+}
 
-            if( !recurse ) {
+int distribution_grid::mod_resource( int amt, bool recurse )
+{
+    if( amt == 0 ) {
+        return 0;
+    }
+    // Full (or empty) batteries wouldn't take any of it, no need to look them up
+    const bool batteries_done = amt > 0 ? *stored_here >= capacity_here : *stored_here <= 0;
+    if( !batteries_done ) {
+        for( const tile_location &loc : batteries ) {
+            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
+            if( battery == nullptr ) {
                 continue;
             }
-
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
-                }
+            // Loaded again since this grid was built, or claimed by a grid built later
+            battery->grid_stored = stored_here;
+            amt = battery->mod_resource( amt );
+            if( amt == 0 ) {
+                break;
             }
         }
     }
 
+    if( amt == 0 || !recurse ) {
+        return amt;
+    }
+
+    const std::vector<vehicle *> vehicles = connected_vehicles();
     // TODO: Giga ugly. We only charge the first vehicle to get it to use its recursive graph traversal because it's inaccessible from here due to being a template method
-    if( !connected_vehicles.empty() ) {
+    if( !vehicles.empty() ) {
         if( amt > 0 ) {
-            amt = connected_vehicles.front()->charge_battery( amt, true );
+            amt = vehicles.front()->charge_battery( amt, true );
         } else {
-            amt = -connected_vehicles.front()->discharge_battery( -amt, true );
+            amt = -vehicles.front()->discharge_battery( -amt, true );
         }
     }
 
@@ -120,54 +143,14 @@ int distribution_grid::mod_resource( int amt, bool recurse )
 
 int distribution_grid::get_resource( bool recurse ) const
 {
-    if( !recurse ) {
-        if( cached_amount_here ) {
-            return *cached_amount_here;
-        } else {
-            cached_amount_here = 0;
+    if( recurse ) {
+        const std::vector<vehicle *> vehicles = connected_vehicles();
+        // The vehicles' traversal counts this grid too, through get_resource( false )
+        if( !vehicles.empty() ) {
+            return vehicles.front()->fuel_left( itype_battery, true );
         }
     }
-    int res = 0;
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                res += battery->get_resource();
-                if( !recurse && cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + res;
-                }
-                continue;
-            }
-
-            if( !recurse ) {
-                continue;
-            }
-
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
-                }
-            }
-        }
-    }
-
-    // TODO: Giga ugly. We only charge the first vehicle to get it to use its recursive graph traversal because it's inaccessible from here due to being a template method
-    if( !connected_vehicles.empty() ) {
-        res = connected_vehicles.front()->fuel_left( itype_battery, true );
-    }
-    if( !recurse ) {
-        cached_amount_here = res;
-    }
-
-    return res;
+    return *stored_here;
 }
 
 distribution_grid_tracker::distribution_grid_tracker()
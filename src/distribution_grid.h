@@ -17,6 +17,7 @@
 class Character;
 class map;
 class mapbuffer;
+class vehicle;
 
 struct tile_location {
     point_sm_ms on_submap;
@@ -46,7 +47,18 @@ class distribution_grid
         std::vector<tripoint_abs_ms> flat_contents;
         std::vector<tripoint_abs_sm> submap_coords;
 
-        mutable cata::optional<int> cached_amount_here;
+        /** The tiles of @ref contents that hold batteries and vehicle connectors. */
+        std::vector<tile_location> batteries;
+        std::vector<tile_location> connectors;
+
+        /**
+         * Charge and capacity of the batteries of this grid, not counting connected vehicles.
+         * The batteries keep the charge up to date themselves, see battery_tile::grid_stored.
+         */
+        shared_ptr_fast<int> stored_here;
+        int capacity_here = 0;
+
+        std::vector<vehicle *> connected_vehicles() const;
 
         mapbuffer &mb;
 
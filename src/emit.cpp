@@ -64,20 +64,12 @@ void emit::finalize()
 {
     for( auto &e : emits_all ) {
         e.second.field_ = field_type_id( e.second.field_name );
-    }
-}
-void emit::check_consistency()
-{
-    for( auto &e : emits_all ) {
         const int max_intensity = e.second.field_.obj().get_max_intensity();
         if( e.second.intensity_ > max_intensity || e.second.intensity_ < 1 ) {
             debugmsg( "emission intensity of %s out of range (%d of max %d)", e.second.id_.c_str(),
                       e.second.intensity_, max_intensity );
             e.second.intensity_ = max_intensity;
         }
-        if( e.second.qty_ <= 0 ) {
-            debugmsg( "emission qty of %s out of range", e.second.id_.c_str() );
-        }
         if( e.second.chance_ > 100 || e.second.chance_ <= 0 ) {
             debugmsg( "emission chance of %s out of range (%d of min 1 max 100)", e.second.id_.c_str(),
                       e.second.chance_ );
@@ -85,6 +77,14 @@ void emit::check_consistency()
         }
     }
 }
+void emit::check_consistency()
+{
+    for( const auto &e : emits_all ) {
+        if( e.second.qty_ <= 0 ) {
+            debugmsg( "emission qty of %s out of range", e.second.id_.c_str() );
+        }
+    }
+}
 
 void emit::reset()
 {
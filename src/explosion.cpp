@@ -156,9 +156,55 @@ explosion_data load_explosion_data( const JsonObject &jo )
 
 namespace explosion_handler
 {
+
+namespace
+{
+
+/** What the regular blasts of a batch did to one tile, applied once the batch is done. */
+struct blast_tile {
+    /** Summed force of the blasts that reached the tile with a force of at least 1. */
+    float force = 0.0f;
+    /** The part of @ref force that came from fiery blasts. */
+    float fire_force = 0.0f;
+    /** Index into the blast colors, -1 if no blast is drawn here. */
+    int color = -1;
+};
+
+struct shrapnel_obstacles {
+    float values[MAPSIZE_X][MAPSIZE_Y] = {};
+};
+
+size_t blast_index( const tripoint &p )
+{
+    return ( static_cast<size_t>( p.z + OVERMAP_DEPTH ) * MAPSIZE_X + p.x ) * MAPSIZE_Y + p.y;
+}
+
+} // namespace
+
+/**
+ * State shared by the explosions resolved together by @ref explosion_queue::execute.
+ * All explosions queued when a batch starts belong to it, the ones they set off go to the
+ * next batch.
+ */
+struct explosion_batch {
+    /**
+     * Obstacles for shrapnel, per z-level. Built the first time a z-level is needed, so
+     * shrapnel sees the terrain as it was before the blasts of the batch.
+     */
+    std::array<std::unique_ptr<shrapnel_obstacles>, OVERMAP_LAYERS> obstacles;
+    /** Blast distance per tile of the blast being resolved, dense over the whole map. */
+    std::vector<float> blast_distance;
+    std::vector<bool> blast_closed;
+    /** Tiles whose @ref blast_distance was set, to reset it for the next blast. */
+    std::vector<tripoint> blast_reached;
+    std::map<tripoint, blast_tile> blasted_tiles;
+    std::map<const Creature *, int> damaged_by_blast;
+    std::map<const Creature *, int> damaged_by_shrapnel;
+};
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
-static std::map<const Creature *, int> do_blast( const tripoint &p, const float power,
-        const float radius, const bool fire )
+static void do_blast( explosion_batch &batch, const tripoint &p, const float power,
+                      const float radius, const bool fire )
 {
     const float tile_dist = 1.0f;
     const float diag_dist = trigdist ? M_SQRT2 * tile_dist : 1.0f * tile_dist;
@@ -173,42 +219,24 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
     map &here = get_map();
     const size_t max_index = here.has_zlevels() ? 10 : 8;
 
-    std::map<const Creature *, int> blasted;
-
     here.bash( p, fire ? power : ( 2 * power ), true, false, false );
 
+    if( batch.blast_distance.empty() ) {
+        const size_t map_tiles = static_cast<size_t>( MAPSIZE_X ) * MAPSIZE_Y * OVERMAP_LAYERS;
+        batch.blast_distance.assign( map_tiles, std::numeric_limits<float>::max() );
+        batch.blast_closed.assign( map_tiles, false );
+    }
+    std::vector<float> &dist_map = batch.blast_distance;
+    std::vector<bool> &is_closed = batch.blast_closed;
+
     std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
     open;
-    std::set<tripoint> closed;
-    std::map<tripoint, float> dist_map;
-    open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
-    // Find all points to blast
-    while( !open.empty() ) {
-        const float distance = open.top().first;
-        const tripoint pt = open.top().second;
-        open.pop();
-
-        if( closed.count( pt ) != 0 ) {
-            continue;
-        }
-
-        closed.insert( pt );
-
-        const float force = power * obstacle_blast_percentage( radius, distance );
-        if( force <= 1.0f ) {
-            continue;
-        }
-
-        if( here.impassable( pt ) && pt != p ) {
-            // Don't propagate further
-            continue;
-        }
-
-        // Iterate over all neighbors. Bash all of them, propagate to some
+    std::vector<tripoint> closed;
+    // Iterate over all neighbors. Bash all of them, propagate to some
+    const auto expand = [&]( const tripoint & pt, const float distance, const float force ) {
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !here.inbounds( dest ) ||
+            if( !here.inbounds( dest ) || is_closed[blast_index( dest )] ||
                 here.obstructed_by_vehicle_rotation( pt, dest ) ) {
                 continue;
             }
@@ -235,36 +263,106 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            float &dest_dist = dist_map[blast_index( dest )];
+            if( dest_dist > next_dist ) {
+                if( dest_dist == std::numeric_limits<float>::max() ) {
+                    batch.blast_reached.push_back( dest );
+                }
                 open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                dest_dist = next_dist;
             }
         }
+    };
+
+    if( here.inbounds( p ) ) {
+        open.push( std::make_pair( 0.0f, p ) );
+        dist_map[blast_index( p )] = 0.0f;
+        batch.blast_reached.push_back( p );
+    } else {
+        // The center has no place in the distance map, but the blast still reaches into the map
+        const float force = power * obstacle_blast_percentage( radius, 0.0f );
+        if( force > 1.0f ) {
+            expand( p, 0.0f, force );
+        }
     }
+    // Find all points to blast
+    while( !open.empty() ) {
+        const float distance = open.top().first;
+        const tripoint pt = open.top().second;
+        open.pop();
 
-    // Draw the explosion
-    std::map<tripoint, nc_color> explosion_colors;
-    for( auto &pt : closed ) {
-        if( here.impassable( pt ) ) {
+        if( is_closed[blast_index( pt )] ) {
             continue;
         }
 
-        float percentage = obstacle_blast_percentage( radius, dist_map.at( pt ) );
-        if( percentage > 0.0f ) {
-            static const std::array<nc_color, 3> colors = { {
-                    c_red, c_yellow, c_white
-                }
-            };
-            size_t color_index = ( power > 30 ? 1 : 0 ) + ( percentage > 0.5f ? 1 : 0 );
+        is_closed[blast_index( pt )] = true;
+        closed.push_back( pt );
+
+        const float force = power * obstacle_blast_percentage( radius, distance );
+        if( force <= 1.0f ) {
+            continue;
+        }
+
+        if( here.impassable( pt ) && pt != p ) {
+            // Don't propagate further
+            continue;
+        }
+
+        expand( pt, distance, force );
+    }
+
+    // The effects are applied by apply_blasts, together with the other blasts of the batch
+    for( const tripoint &pt : closed ) {
+        const float percentage = obstacle_blast_percentage( radius, dist_map[blast_index( pt )] );
+        if( percentage <= 0.0f ) {
+            continue;
+        }
+        blast_tile &tile = batch.blasted_tiles[pt];
+        const int color_index = ( power > 30 ? 1 : 0 ) + ( percentage > 0.5f ? 1 : 0 );
+        tile.color = std::max( tile.color, color_index );
+        const float force = power * percentage;
+        if( force >= 1.0f ) {
+            tile.force += force;
+            if( fire ) {
+                tile.fire_force += force;
+            }
+        }
+    }
+
+    for( const tripoint &pt : batch.blast_reached ) {
+        dist_map[blast_index( pt )] = std::numeric_limits<float>::max();
+        is_closed[blast_index( pt )] = false;
+    }
+    batch.blast_reached.clear();
+}
+
+/** Draws the blasts of a batch and applies their force to the tiles they reached. */
+static void apply_blasts( explosion_batch &batch )
+{
+    if( batch.blasted_tiles.empty() ) {
+        return;
+    }
+    map &here = get_map();
 
-            explosion_colors[pt] = colors[color_index];
+    // Draw the explosion
+    std::map<tripoint, nc_color> explosion_colors;
+    for( const auto &pr : batch.blasted_tiles ) {
+        if( pr.second.color < 0 || here.impassable( pr.first ) ) {
+            continue;
         }
+        static const std::array<nc_color, 3> colors = { {
+                c_red, c_yellow, c_white
+            }
+        };
+        explosion_colors[pr.first] = colors[pr.second.color];
     }
 
     draw_custom_explosion( g->u.pos(), explosion_colors, "explosion" );
 
-    for( const tripoint &pt : closed ) {
-        const float force = power * obstacle_blast_percentage( radius, dist_map.at( pt ) );
+    for( const auto &pr : batch.blasted_tiles ) {
+        const tripoint &pt = pr.first;
+        const float force = pr.second.force;
+        const float fire_force = pr.second.fire_force;
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -272,8 +370,8 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
 
         here.smash_items( pt, force, _( "force of the explosion" ), true );
 
-        if( fire ) {
-            int intensity = 1 + ( force > 10.0f ) + ( force > 30.0f );
+        if( fire_force >= 1.0f ) {
+            int intensity = 1 + ( fire_force > 10.0f ) + ( fire_force > 30.0f );
 
             if( !here.has_zlevels() && here.is_outside( pt ) && intensity == 2 ) {
                 // In 3D mode, it would have fire fields above, which would then fall
@@ -286,7 +384,12 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
 
         if( const optional_vpart_position vp = here.veh_at( pt ) ) {
             // TODO: Make this weird unit used by vehicle::damage more sensible
-            vp->vehicle().damage( vp->part_index(), force, fire ? DT_HEAT : DT_BASH, false );
+            if( fire_force >= 1.0f ) {
+                vp->vehicle().damage( vp->part_index(), fire_force, DT_HEAT, false );
+            }
+            if( force - fire_force >= 1.0f ) {
+                vp->vehicle().damage( vp->part_index(), force - fire_force, DT_BASH, false );
+            }
         }
 
         Creature *critter = g->critter_at( pt, true );
@@ -301,7 +404,7 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
             const int actual_dmg = rng_float( dmg, dmg * 2 );
             critter->apply_damage( nullptr, bodypart_id( "torso" ), actual_dmg );
             critter->check_dead_state();
-            blasted[critter] = actual_dmg;
+            batch.damaged_by_blast[critter] += actual_dmg;
             continue;
         }
 
@@ -335,12 +438,10 @@ static std::map<const Creature *, int> do_blast( const tripoint &p, const float
 
             add_msg( m_debug, "%s for %d raw, %d actual", hit_part_name, part_dam, res_dmg );
             if( res_dmg > 0 ) {
-                blasted[critter] += res_dmg;
+                batch.damaged_by_blast[critter] += res_dmg;
             }
         }
     }
-
-    return blasted;
 }
 
 static std::map<const Creature *, int> do_blast_new( const tripoint &blast_center,
@@ -609,14 +710,14 @@ static std::map<const Creature *, int> do_blast_new( const tripoint &blast_cente
 }
 
 
-static std::map<const Creature *, int> shrapnel( const tripoint &src, const projectile &fragment )
+static std::map<const Creature *, int> shrapnel( explosion_batch &batch, const tripoint &src,
+        const projectile &fragment )
 {
     std::map<const Creature *, int> damaged;
 
     projectile proj = fragment;
     proj.add_effect( ammo_effect_NULL_SOURCE );
 
-    float obstacle_cache[MAPSIZE_X][MAPSIZE_Y] = {};
     float visited_cache[MAPSIZE_X][MAPSIZE_Y] = {};
 
     map &here = get_map();
@@ -629,7 +730,13 @@ static std::map<const Creature *, int> shrapnel( const tripoint &src, const proj
     // Need to update shadowcasting to support limiting range without adjusting initial distance.
     const tripoint_range<tripoint> area = here.points_on_zlevel( src.z );
 
-    here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east, obstacle_cache );
+    std::unique_ptr<shrapnel_obstacles> &obstacles = batch.obstacles[src.z + OVERMAP_DEPTH];
+    if( !obstacles ) {
+        obstacles = std::make_unique<shrapnel_obstacles>();
+        here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east,
+                                   obstacles->values );
+    }
+    float ( &obstacle_cache )[MAPSIZE_X][MAPSIZE_Y] = obstacles->values;
 
     // Shadowcasting normally ignores the origin square,
     // so apply it manually to catch monsters standing on the explosive.
@@ -717,7 +824,7 @@ void explosion( const tripoint &p, const explosion_data &ex )
     get_explosion_queue().add( std::move( qe ) );
 }
 
-void explosion_funcs::regular( const queued_explosion &qe )
+void explosion_funcs::regular( const queued_explosion &qe, explosion_batch &batch )
 {
     const tripoint &p = qe.pos;
     const explosion_data &ex = qe.exp_data;
@@ -733,20 +840,29 @@ void explosion_funcs::regular( const queued_explosion &qe )
         sounds::sound( p, 3, sounds::sound_t::combat, _( "a loud pop!" ), false, "explosion", "small" );
     }
 
-    std::map<const Creature *, int> damaged_by_blast;
-    std::map<const Creature *, int> damaged_by_shrapnel;
     const auto &shr = ex.fragment;
     if( shr ) {
-        damaged_by_shrapnel = shrapnel( p, shr.value() );
+        for( const auto &pr : shrapnel( batch, p, shr.value() ) ) {
+            batch.damaged_by_shrapnel[pr.first] += pr.second;
+        }
     }
 
     if( ex.radius >= 0.0f && ex.damage > 0.0f ) {
         if( get_option<bool>( "NEW_EXPLOSIONS" ) && !ex.fire ) {
-            damaged_by_blast = do_blast_new( p, ex.damage, ex.radius );
+            for( const auto &pr : do_blast_new( p, ex.damage, ex.radius ) ) {
+                batch.damaged_by_blast[pr.first] += pr.second;
+            }
         } else {
-            damaged_by_blast = do_blast( p, ex.damage, ex.radius, ex.fire );
+            do_blast( batch, p, ex.damage, ex.radius, ex.fire );
         }
     }
+}
+
+/** Tells who got hurt by the explosions of a batch, once per creature. */
+static void report_damage( const explosion_batch &batch )
+{
+    const std::map<const Creature *, int> &damaged_by_blast = batch.damaged_by_blast;
+    const std::map<const Creature *, int> &damaged_by_shrapnel = batch.damaged_by_shrapnel;
 
     // Not the cleanest way to do it
     std::map<const Creature *, int> total_damaged;
@@ -1173,28 +1289,39 @@ explosion_queue &get_explosion_queue()
     return singleton;
 }
 
+static void execute_one( const queued_explosion &exp, explosion_batch &batch )
+{
+    switch( exp.type ) {
+        case ExplosionType::Regular:
+            explosion_funcs::regular( exp, batch );
+            break;
+        case ExplosionType::Flashbang:
+            explosion_funcs::flashbang( exp );
+            break;
+        case ExplosionType::ResonanceCascade:
+            explosion_funcs::resonance_cascade( exp );
+            break;
+        case ExplosionType::Shockwave:
+            explosion_funcs::shockwave( exp );
+            break;
+        default:
+            debugmsg( "Explosion type not implemented." );
+            break;
+    }
+}
+
 void explosion_queue::execute()
 {
     while( !elems.empty() ) {
-        queued_explosion exp = std::move( elems.front() );
-        elems.pop_front();
-        switch( exp.type ) {
-            case ExplosionType::Regular:
-                explosion_funcs::regular( exp );
-                break;
-            case ExplosionType::Flashbang:
-                explosion_funcs::flashbang( exp );
-                break;
-            case ExplosionType::ResonanceCascade:
-                explosion_funcs::resonance_cascade( exp );
-                break;
-            case ExplosionType::Shockwave:
-                explosion_funcs::shockwave( exp );
-                break;
-            default:
-                debugmsg( "Explosion type not implemented." );
-                break;
+        // Explosions set off by this batch go to the next one
+        std::deque<queued_explosion> batch_elems = std::move( elems );
+        elems.clear();
+        explosion_batch batch;
+        for( const queued_explosion &exp : batch_elems ) {
+            execute_one( exp, batch );
         }
+        apply_blasts( batch );
+        report_damage( batch );
     }
 }
 
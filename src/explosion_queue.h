@@ -36,10 +36,12 @@ struct queued_explosion {
     bool affects_player = false;
 };
 
+struct explosion_batch;
+
 namespace explosion_funcs
 {
 
-void regular( const queued_explosion &qe );
+void regular( const queued_explosion &qe, explosion_batch &batch );
 void flashbang( const queued_explosion &qe );
 void resonance_cascade( const queued_explosion &qe );
 void shockwave( const queued_explosion &qe );
@@ -56,6 +58,10 @@ class explosion_queue
             elems.push_back( std::move( exp ) );
         }
 
+        /**
+         * Resolves the queued explosions in batches: the ones queued when a batch starts are
+         * resolved together, those they set off form the next batch.
+         */
         void execute();
 
         inline void clear() {
@@ -140,11 +140,55 @@ time_duration field_entry::set_field_age( const time_duration &new_age )
     return age = new_age;
 }
 
+field::pin::pin( field &pinned ) : pinned( pinned )
+{
+    if( pinned._pins++ > 0 ) {
+        return;
+    }
+    std::vector<entry> &entries = pinned._field_type_list;
+    pinned._sorted = static_cast<std::uint8_t>( entries.size() );
+    // Added entries must not move the others, so make room for them up front.
+    // This only allocates the first time a tile gets pinned.
+    entries.reserve( entries.size() + pinned_additions );
+}
+
+field::pin::~pin()
+{
+    if( --pinned._pins > 0 ) {
+        return;
+    }
+    std::vector<entry> &entries = pinned._field_type_list;
+    entries.erase( std::remove_if( entries.begin(), entries.end(), []( const entry & e ) {
+        return !e.second.get_field_type();
+    } ), entries.end() );
+    if( entries.size() > pinned._sorted ) {
+        std::sort( entries.begin(), entries.end(), []( const entry & l, const entry & r ) {
+            return l.first < r.first;
+        } );
+    }
+}
+
 field::field()
     : _displayed_field_type( fd_null )
 {
 }
 
+field::iterator field::lower_bound( const field_type_id &type )
+{
+    return std::lower_bound( begin(), end(), type,
+    []( const entry & e, const field_type_id & t ) {
+        return e.first < t;
+    } );
+}
+
+field::const_iterator field::lower_bound( const field_type_id &type ) const
+{
+    return std::lower_bound( begin(), end(), type,
+    []( const entry & e, const field_type_id & t ) {
+        return e.first < t;
+    } );
+}
+
 /*
 Function: find_field
 Returns a field entry corresponding to the field_type_id parameter passed in. If no fields are found then returns NULL.
@@ -152,14 +196,7 @@ Good for checking for existence of a field: if(myfield.find_field(fd_fire)) woul
 */
 field_entry *field::find_field( const field_type_id &field_type_to_find )
 {
-    if( !_displayed_field_type ) {
-        return nullptr;
-    }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    return const_cast<field_entry *>( find_field_c( field_type_to_find ) );
 }
 
 const field_entry *field::find_field_c( const field_type_id &field_type_to_find ) const
@@ -167,11 +204,17 @@ const field_entry *field::find_field_c( const field_type_id &field_type_to_find
     if( !_displayed_field_type ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
+    auto it = lower_bound( field_type_to_find );
+    if( it == end() || it->first != field_type_to_find ) {
+        it = std::find_if( end(), _field_type_list.end(), [&field_type_to_find]( const entry & e ) {
+            return e.first == field_type_to_find;
+        } );
+        if( it == _field_type_list.end() ) {
+            return nullptr;
+        }
     }
-    return nullptr;
+    // Entries removed from a pinned field stay around with a null type.
+    return it->second.get_field_type() ? &it->second : nullptr;
 }
 
 const field_entry *field::find_field( const field_type_id &field_type_to_find ) const
@@ -195,15 +238,14 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         debugmsg( "Tried to add null field" );
         return false;
     }
-    auto it = _field_type_list.find( field_type_to_add );
-    if( it != _field_type_list.end() ) {
+    if( field_entry *const existing = find_field( field_type_to_add ) ) {
         // Most fields stack intensities, but some add duration instead
-        if( it->first->stacking_type == fields::stacking_type::intensity ) {
-            it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
+        if( field_type_to_add->stacking_type == fields::stacking_type::intensity ) {
+            existing->set_field_intensity( existing->get_field_intensity() + new_intensity );
         } else {
             time_duration half_life = field_type_to_add->half_life;
             if( new_age < half_life ) {
-                it->second.mod_field_age( new_age - half_life );
+                existing->mod_field_age( new_age - half_life );
             }
         }
         return false;
@@ -212,30 +254,76 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    const field_entry added( field_type_to_add, new_intensity, new_age );
+    const auto it = lower_bound( field_type_to_add );
+    if( _pins == 0 ) {
+        _field_type_list.emplace( it, field_type_to_add, added );
+        return true;
+    }
+    // Removed while pinned, so it can be reused in place.
+    if( it != end() && it->first == field_type_to_add ) {
+        it->second = added;
+        return true;
+    }
+    const auto removed = std::find_if( end(), _field_type_list.end(),
+    [&field_type_to_add]( const entry & e ) {
+        return e.first == field_type_to_add;
+    } );
+    if( removed != _field_type_list.end() ) {
+        removed->second = added;
+        return true;
+    }
+    if( _field_type_list.size() == _field_type_list.capacity() ) {
+        debugmsg( "Can't add %s to a field that already got %d new fields while pinned",
+                  field_type_to_add.id().str(), pinned_additions );
+        update_displayed_field_type();
+        return false;
+    }
+    _field_type_list.emplace_back( field_type_to_add, added );
     return true;
 }
 
 bool field::remove_field( const field_type_id &field_to_remove )
 {
-    const auto it = _field_type_list.find( field_to_remove );
-    if( it == _field_type_list.end() ) {
+    auto it = lower_bound( field_to_remove );
+    if( it == end() || it->first != field_to_remove ) {
+        it = std::find_if( end(), _field_type_list.end(), [&field_to_remove]( const entry & e ) {
+            return e.first == field_to_remove;
+        } );
+    }
+    if( it == _field_type_list.end() || !it->second.get_field_type() ) {
         return false;
     }
     remove_field( it );
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+field::iterator field::remove_field( iterator it )
+{
+    if( _pins > 0 ) {
+        it->second = field_entry();
+        ++it;
+    } else {
+        it = _field_type_list.erase( it );
+    }
+    update_displayed_field_type();
+    return it;
+}
+
+void field::update_displayed_field_type()
 {
-    _field_type_list.erase( it );
     _displayed_field_type = fd_null;
-    if( !_field_type_list.empty() ) {
-        for( auto &fld : _field_type_list ) {
-            if( !_displayed_field_type || fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
-                _displayed_field_type = fld.first;
-            }
+    const auto consider = [this]( const entry & e ) {
+        if( !e.second.get_field_type() ) {
+            return;
+        }
+        if( !_displayed_field_type ||
+            e.first.obj().priority >= _displayed_field_type.obj().priority ) {
+            _displayed_field_type = e.first;
         }
+    };
+    for( const entry &e : _field_type_list ) {
+        consider( e );
     }
 }
 
@@ -245,27 +333,32 @@ Returns the number of fields existing on the current tile.
 */
 unsigned int field::field_count() const
 {
-    return _field_type_list.size();
+    if( _pins == 0 ) {
+        return _field_type_list.size();
+    }
+    return std::count_if( _field_type_list.begin(), _field_type_list.end(), []( const entry & e ) {
+        return static_cast<bool>( e.second.get_field_type() );
+    } );
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::iterator field::begin()
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::const_iterator field::begin() const
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::iterator field::end()
 {
-    return _field_type_list.end();
+    return _pins > 0 ? _field_type_list.begin() + _sorted : _field_type_list.end();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::const_iterator field::end() const
 {
-    return _field_type_list.end();
+    return _pins > 0 ? _field_type_list.begin() + _sorted : _field_type_list.end();
 }
 
 /*
@@ -286,7 +379,9 @@ int field::total_move_cost() const
 {
     int current_cost = 0;
     for( auto &fld : _field_type_list ) {
-        current_cost += fld.second.move_cost();
+        if( fld.second.get_field_type() ) {
+            current_cost += fld.second.move_cost();
+        }
     }
     return current_cost;
 }
@@ -2,8 +2,9 @@
 #ifndef CATA_SRC_FIELD_H
 #define CATA_SRC_FIELD_H
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -86,11 +87,11 @@ class field_entry
         }
 
         //Returns true if this is an active field, false if it should be removed.
-        bool is_field_alive() {
+        bool is_field_alive() const {
             return is_alive;
         }
 
-        bool gas_can_spread() {
+        bool gas_can_spread() const {
             return is_field_alive() && type.obj().phase == GAS && type.obj().percent_spread > 0;
         }
 
@@ -126,10 +127,40 @@ class field_entry
  * Use @ref find_field to get the field entry of a specific type, or iterate over
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref displayed_field_type to specific which field should be drawn on the map.
+ *
+ * The entries are kept in a vector sorted by type, as almost all tiles have no more than one
+ * or two of them. Adding or removing a field type moves the other entries, see @ref pin.
 */
 class field
 {
     public:
+        using entry = std::pair<field_type_id, field_entry>;
+        using iterator = std::vector<entry>::iterator;
+        using const_iterator = std::vector<entry>::const_iterator;
+
+        // How many field types can be added to a pinned field.
+        static constexpr int pinned_additions = 4;
+
+        /**
+         * Keeps references and iterators to the entries of a field valid while it exists, even
+         * when fields get added to or removed from the same tile in the meantime.
+         * Field types added meanwhile go to spare room behind the sorted entries, and only show
+         * up when iterating after the last pin of the field is gone. There is room for
+         * @ref pinned_additions of them. Removed ones stay in place as entries of type fd_null.
+         */
+        class pin
+        {
+            public:
+                explicit pin( field &pinned );
+                ~pin();
+
+                pin( const pin & ) = delete;
+                pin &operator=( const pin & ) = delete;
+
+            private:
+                field &pinned;
+        };
+
         field();
 
         /**
@@ -168,8 +199,9 @@ class field
         /**
          * Make sure to decrement the field counter in the submap.
          * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * @return Iterator to the entry after the removed one.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        iterator remove_field( iterator it );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -182,12 +214,12 @@ class field
         description_affix displayed_description_affix() const;
 
         //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        iterator begin();
+        const_iterator begin() const;
 
         //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        iterator end();
+        const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -195,10 +227,18 @@ class field
         int total_move_cost() const;
 
     private:
-        // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        iterator lower_bound( const field_type_id &type );
+        const_iterator lower_bound( const field_type_id &type ) const;
+        void update_displayed_field_type();
+
+        // All field effects on the current tile, sorted by type. While pinned, only the first
+        // _sorted ones are, the ones behind them were added since.
+        std::vector<entry> _field_type_list;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
+        // Number of pins currently held on this field.
+        std::uint8_t _pins = 0;
+        std::uint8_t _sorted = 0;
 };
 
 #endif // CATA_SRC_FIELD_H
@@ -0,0 +1,53 @@
+#include "fov_cache.h"
+
+#include <utility>
+
+fov_cache::fov_cache() = default;
+fov_cache::fov_cache( fov_cache && ) = default;
+fov_cache::~fov_cache() = default;
+fov_cache &fov_cache::operator=( fov_cache && ) = default;
+
+const fov_cache::bitmap *fov_cache::find( const tripoint &origin, const int turn )
+{
+    if( turn != last_turn ) {
+        clear();
+        last_turn = turn;
+        return nullptr;
+    }
+    const auto iter = entries.find( origin );
+    return iter == entries.end() ? nullptr : iter->second.get();
+}
+
+fov_cache::bitmap &fov_cache::insert( const tripoint &origin )
+{
+    if( entries.size() >= max_size ) {
+        clear();
+    }
+    std::unique_ptr<bitmap> &entry = entries[origin];
+    if( !entry ) {
+        if( spare.empty() ) {
+            entry = std::make_unique<bitmap>();
+        } else {
+            entry = std::move( spare.back() );
+            spare.pop_back();
+            entry->reset();
+        }
+    }
+    return *entry;
+}
+
+void fov_cache::clear()
+{
+    for( auto &entry : entries ) {
+        spare.push_back( std::move( entry.second ) );
+    }
+    entries.clear();
+}
+
+float ( &fov_cache::scratch() )[MAPSIZE_X][MAPSIZE_Y]
+{
+    if( !scratch_grid ) {
+        scratch_grid = std::make_unique<grid>();
+    }
+    return scratch_grid->values;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef CATA_SRC_FOV_CACHE_H
+#define CATA_SRC_FOV_CACHE_H
+
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "game_constants.h"
+#include "point.h"
+
+/**
+ * Shadowcast fields of view from single tiles, shared by every creature standing there.
+ * See @ref map::sees_with_fov.
+ *
+ * Everything is dropped when the turn changes or the transparency of the map does.
+ * Bitmaps of dropped entries are kept around and reused.
+ */
+class fov_cache
+{
+    public:
+        using bitmap = std::bitset<MAPSIZE_X *MAPSIZE_Y>;
+
+        fov_cache();
+        fov_cache( fov_cache && );
+        ~fov_cache();
+        fov_cache &operator=( fov_cache && );
+
+        /** Field of view from origin, or nullptr if it wasn't computed during this turn. */
+        const bitmap *find( const tripoint &origin, int turn );
+        /** Adds an empty field of view for origin, to be filled by the caller. */
+        bitmap &insert( const tripoint &origin );
+        void clear();
+
+        size_t size() const {
+            return entries.size();
+        }
+        /** Fields of view stored before the cache clears itself. */
+        static constexpr size_t max_size = 1024;
+
+        /** Scratch output for the shadowcasting, kept to avoid reallocating it. */
+        float ( &scratch() )[MAPSIZE_X][MAPSIZE_Y];
+
+    private:
+        std::unordered_map<tripoint, std::unique_ptr<bitmap>> entries;
+        std::vector<std::unique_ptr<bitmap>> spare;
+        struct grid {
+            float values[MAPSIZE_X][MAPSIZE_Y];
+        };
+        std::unique_ptr<grid> scratch_grid;
+        int last_turn = 0;
+};
+
+#endif // CATA_SRC_FOV_CACHE_H
@@ -41,6 +41,7 @@
 #include "auto_pickup.h"
 #include "avatar.h"
 #include "avatar_action.h"
+#include "background_save.h"
 #include "basecamp.h"
 #include "bionics.h"
 #include "bodypart.h"
@@ -155,6 +156,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -369,7 +371,8 @@ bool game::check_mod_data( const std::vector<mod_id> &opts, loading_ui &ui )
         // if no loadable mods then test core data only
         try {
             load_core_data( ui );
-            DynamicDataLoader::get_instance().finalize_loaded_data( ui );
+            // Checking the data is the whole point here
+            DynamicDataLoader::get_instance().finalize_loaded_data( ui, true );
         } catch( const std::exception &err ) {
             std::cerr << "Error loading data from json: " << err.what() << std::endl;
         }
@@ -417,7 +420,8 @@ bool game::check_mod_data( const std::vector<mod_id> &opts, loading_ui &ui )
 
             // Load mod itself
             load_data_from_dir( mod.path, mod.ident.str(), ui );
-            DynamicDataLoader::get_instance().finalize_loaded_data( ui );
+            // Checking the data is the whole point here
+            DynamicDataLoader::get_instance().finalize_loaded_data( ui, true );
         } catch( const std::exception &err ) {
             std::cerr << "Error loading data: " << err.what() << std::endl;
         }
@@ -1030,6 +1034,7 @@ static std::string generate_memorial_filename( const std::string &char_name )
 
 bool game::cleanup_at_end()
 {
+    background_save::wait();
     if( uquit == QUIT_DIED || uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
         for( monster &critter : all_monsters() ) {
@@ -1439,6 +1444,7 @@ bool game::do_turn()
     if( is_game_over() ) {
         return cleanup_at_end();
     }
+    turn_profiler::end_turn();
     // Actual stuff
     if( new_game ) {
         new_game = false;
@@ -1455,8 +1461,11 @@ bool game::do_turn()
         load_npcs();
     }
 
-    timed_events.process();
-    mission::process_all();
+    {
+        CATA_TURN_PHASE( "timed events and missions" );
+        timed_events.process();
+        mission::process_all();
+    }
     // If controlling a vehicle that is owned by someone else
     if( u.in_vehicle && u.controlling_vehicle ) {
         vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) );
@@ -1469,11 +1478,13 @@ bool game::do_turn()
         u.check_mount_is_spooked();
     }
     if( calendar::once_every( 1_days ) ) {
+        CATA_TURN_PHASE( "process_mongroups" );
         overmap_buffer.process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        CATA_TURN_PHASE( "move_hordes" );
         overmap_buffer.move_hordes();
         // Hordes that reached the reality bubble need to spawn,
         // make them spawn in invisible areas only.
@@ -1488,15 +1499,23 @@ bool game::do_turn()
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
+        CATA_TURN_PHASE( "autosave" );
         autosave();
     }
+    background_save::poll();
 
-    weather.update_weather();
-    reset_light_level();
+    {
+        CATA_TURN_PHASE( "weather" );
+        weather.update_weather();
+        reset_light_level();
+    }
 
     perhaps_add_random_npc();
     process_voluntary_act_interrupt();
-    process_activity();
+    {
+        CATA_TURN_PHASE( "process_activity" );
+        process_activity();
+    }
     // Process NPC sound events before they move or they hear themselves talking
     for( npc &guy : all_npcs() ) {
         if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
@@ -1572,29 +1591,61 @@ bool game::do_turn()
         scent.set( u.pos(), u.scent, u.get_type_of_scent() );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
+    {
+        CATA_TURN_PHASE( "scent" );
+        scent.update( u.pos(), m );
+    }
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        CATA_TURN_PHASE( "build_floor_caches" );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    autopilot_vehicles();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
+    {
+        CATA_TURN_PHASE( "process_falling" );
+        m.process_falling();
+    }
+    {
+        CATA_TURN_PHASE( "vehmove" );
+        autopilot_vehicles();
+        m.vehmove();
+    }
+    {
+        CATA_TURN_PHASE( "process_fields" );
+        m.process_fields();
+    }
+    {
+        CATA_TURN_PHASE( "process_items" );
+        m.process_items();
+    }
     m.creature_in_field( u );
-    grid_tracker_ptr->update( calendar::turn );
-
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
+    {
+        CATA_TURN_PHASE( "distribution grids" );
+        grid_tracker_ptr->update( calendar::turn );
+    }
+
+    {
+        CATA_TURN_PHASE( "process_sounds" );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
+    {
+        CATA_TURN_PHASE( "build_map_cache" );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( get_levz(), true );
+    }
+    {
+        CATA_TURN_PHASE( "monmove" );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
+        CATA_TURN_PHASE( "overmap_npc_move" );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
+        CATA_TURN_PHASE( "furniture emissions" );
         for( const tripoint &elem : m.get_furn_field_locations() ) {
             const auto &furn = m.furn( elem ).obj();
             for( const emit_id &e : furn.emissions ) {
@@ -1604,10 +1655,19 @@ bool game::do_turn()
     }
     update_stair_monsters();
     mon_info_update();
-    u.process_turn();
+    {
+        CATA_TURN_PHASE( "player process_turn" );
+        u.process_turn();
+    }
 
-    explosion_handler::get_explosion_queue().execute();
-    cleanup_dead();
+    {
+        CATA_TURN_PHASE( "explosions" );
+        explosion_handler::get_explosion_queue().execute();
+    }
+    {
+        CATA_TURN_PHASE( "cleanup_dead" );
+        cleanup_dead();
+    }
 
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
         ui_manager::redraw();
@@ -3720,9 +3780,25 @@ Creature *game::is_hostile_very_close()
 
 Creature *game::is_hostile_within( int distance )
 {
-    for( auto &critter : u.get_visible_creatures( distance ) ) {
-        if( u.attitude_to( *critter ) == Creature::A_HOSTILE ) {
-            return critter;
+    const auto is_hostile = [this, distance]( const Creature & critter ) {
+        return u.pos() != critter.pos() && rl_dist( u.pos(), critter.pos() ) <= distance &&
+               u.attitude_to( critter ) == Creature::A_HOSTILE && u.sees( critter );
+    };
+    const std::vector<monster *> monsters = critter_tracker->monsters_within( u.pos(), distance,
+                                            is_hostile );
+    if( monsters.size() == 1 ) {
+        return monsters.front();
+    } else if( !monsters.empty() ) {
+        // Report the same monster a scan of the whole list would, not whichever cell came first.
+        for( const shared_ptr_fast<monster> &critter : critter_tracker->get_monsters_list() ) {
+            if( std::find( monsters.begin(), monsters.end(), critter.get() ) != monsters.end() ) {
+                return critter.get();
+            }
+        }
+    }
+    for( npc &guy : all_npcs() ) {
+        if( is_hostile( guy ) ) {
+            return &guy;
         }
     }
 
@@ -11307,10 +11383,21 @@ void game::quicksave()
     ui_manager::redraw();
     refresh_display();
 
+    save_and_reset_timer( false );
+}
+
+void game::save_and_reset_timer( const bool in_background )
+{
     time_t now = time( nullptr ); //timestamp for start of saving procedure
 
     //perform save
-    save();
+    if( in_background ) {
+        // Only serializes the game here, the files get written while the game goes on.
+        background_save::batch batch;
+        save();
+    } else {
+        save();
+    }
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -11323,6 +11410,7 @@ void game::quickload()
         return;
     }
 
+    background_save::wait();
     if( active_world->save_exists( save_t::from_player_name( u.name ) ) ) {
         if( moves_since_last_save != 0 ) { // See if we need to reload anything
             MAPBUFFER.reset();
@@ -11345,7 +11433,13 @@ void game::autosave()
     if( time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
         return;
     }
-    quicksave();    //Driving checks are handled by quicksave()
+    //Don't autosave if the player hasn't done anything since the last autosave/quicksave,
+    if( !moves_since_last_save ) {
+        return;
+    }
+    add_msg( m_info, _( "Autosaving…" ) );
+
+    save_and_reset_timer( true );
 }
 
 void game::process_artifact( item &it, player &p )
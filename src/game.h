@@ -919,6 +919,8 @@ class game
 
         //  int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
         void autosave();         // automatic quicksaves - Performs some checks before calling quicksave()
+        // Saves and restarts the autosave timer, writing the files in the background if asked
+        void save_and_reset_timer( bool in_background );
     public:
         void quicksave();        // Saves the game without quitting
         void disp_NPCs();        // Currently for debug use.  Lists global NPCs.
@@ -716,7 +716,7 @@ static void smash()
             crit->use_mech_power( -3 );
         }
     }
-    for( std::pair<const field_type_id, field_entry> &fd_to_smsh : here.field_at( smashp ) ) {
+    for( field::entry &fd_to_smsh : here.field_at( smashp ) ) {
         const map_bash_info &bash_info = fd_to_smsh.first->bash_info;
         if( bash_info.str_min == -1 ) {
             continue;
@@ -727,7 +727,9 @@ static void smash()
         } else if( smashskill >= rng( bash_info.str_min, bash_info.str_max ) ) {
             sounds::sound( smashp, bash_info.sound_vol.value_or( -1 ),
                            sounds::sound_t::combat, bash_info.sound, true, "smash", "field" );
-            here.remove_field( smashp, fd_to_smsh.first );
+            // Copied, the entry is gone once removed.
+            const field_type_id smashed = fd_to_smsh.first;
+            here.remove_field( smashp, smashed );
             here.spawn_items( smashp, item_group::items_from( bash_info.drop_group, calendar::turn ) );
             u.mod_moves( - bash_info.fd_bash_move_cost );
             add_msg( m_info, bash_info.field_bash_msg_success.translated() );
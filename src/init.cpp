@@ -1,6 +1,9 @@
 #include "init.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <fstream>
@@ -9,8 +12,13 @@
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
 #include "achievement.h"
 #include "activity_type.h"
 #include "ammo.h"
@@ -39,9 +47,11 @@
 #include "field_type.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
+#include "get_version.h"
 #include "flag.h"
 #include "gates.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "item_action.h"
 #include "item_category.h"
 #include "item_factory.h"
@@ -67,11 +77,13 @@
 #include "npc.h"
 #include "npc_class.h"
 #include "omdata.h"
+#include "options.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -471,18 +483,42 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    const auto start = std::chrono::steady_clock::now();
+    // Read the files on as many threads as the hardware offers, it's mostly waiting for the disk.
+    // Parsing and loading stays on this thread, in file order: the type loaders build up
+    // global state, and later objects may refer to earlier ones.
+    std::vector<std::string> contents( files.size() );
+    std::vector<std::size_t> hashes( files.size() );
+    std::atomic<size_t> next_file( 0 );
+    const auto read_files = [&]() {
+        for( size_t i = next_file++; i < files.size(); i = next_file++ ) {
+            contents[i] = read_entire_file( files[i] );
+            hashes[i] = std::hash<std::string>()( contents[i] );
+        }
+    };
+    const size_t thread_count = std::min<size_t>( files.size(),
+                                std::max( 1U, std::thread::hardware_concurrency() ) );
+    std::vector<std::thread> workers;
+    for( size_t i = 1; i < thread_count; ++i ) {
+        workers.emplace_back( read_files );
+    }
+    read_files();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+    const auto read = std::chrono::steady_clock::now();
+    times.reading += std::chrono::duration<double>( read - start ).count();
+    cata::hash_combine( data_fingerprint, src );
+    for( size_t i = 0; i < files.size(); ++i ) {
+        cata::hash_combine( data_fingerprint, files[i] );
+        cata::hash_combine( data_fingerprint, hashes[i] );
+    }
+
+    for( size_t i = 0; i < files.size(); ++i ) {
+        const std::string &file = files[i];
+        std::istringstream iss( contents[i] );
+        contents[i].clear();
+        contents[i].shrink_to_fit();
         try {
             // parse it
             JsonIn jsin( iss, file );
@@ -491,6 +527,8 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             throw std::runtime_error( err.what() );
         }
     }
+    times.loading += std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                     read ).count();
 }
 
 void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
@@ -524,6 +562,8 @@ void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    times = phase_times();
+    data_fingerprint = 0;
 
     achievement::reset();
     activity_type::reset();
@@ -624,7 +664,22 @@ void DynamicDataLoader::finalize_loaded_data()
     finalize_loaded_data( ui );
 }
 
-void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
+/** Where the fingerprint of the last data that passed the checks is kept. */
+static std::string checked_fingerprint_path()
+{
+    return PATH_INFO::config_dir() + "checked_data.txt";
+}
+
+static std::string read_checked_fingerprint()
+{
+    std::string result;
+    read_from_file_optional( checked_fingerprint_path(), [&result]( std::istream & fin ) {
+        fin >> result;
+    } );
+    return result;
+}
+
+void DynamicDataLoader::finalize_loaded_data( loading_ui &ui, const bool force_checks )
 {
     assert( !finalized && "Can't finalize the data twice." );
     assert( !stream_cache && "Expected stream cache to be null before finalization" );
@@ -634,6 +689,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
     } );
     stream_cache = std::make_unique<cached_streams>();
 
+    const auto start = std::chrono::steady_clock::now();
     ui.new_context( _( "Finalizing" ) );
 
     using named_entry = std::pair<std::string, std::function<void()>>;
@@ -667,6 +723,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
             { _( "Overmap specials" ), &overmap_specials::finalize },
             { _( "Overmap locations" ), &overmap_locations::finalize },
             { _( "Start locations" ), &start_locations::finalize_all },
+            { _( "Scenarios" ), &scenario::finalize_all },
             { _( "Zone manager" ), &zone_manager::reset_manager },
             { _( "Vehicle prototypes" ), &vehicle_prototype::finalize },
             { _( "Mapgen weights" ), &calculate_mapgen_weights },
@@ -706,9 +763,34 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
         e.second();
         ui.proceed();
     }
-
-    check_consistency( ui );
+    const auto finalized_at = std::chrono::steady_clock::now();
+    times.finalizing += std::chrono::duration<double>( finalized_at - start ).count();
+
+    // Checking takes a good part of the loading time, and it can only find what it found
+    // the last time if neither the data nor the game changed.
+    std::size_t fingerprint = data_fingerprint;
+    cata::hash_combine( fingerprint, std::string( getVersionString() ) );
+    const std::string fingerprint_str = std::to_string( fingerprint );
+    const bool skip_checks = !force_checks && get_option<bool>( "SKIP_UNCHANGED_DATA_CHECKS" ) &&
+                             read_checked_fingerprint() == fingerprint_str;
+    if( skip_checks ) {
+        DebugLog( DL::Info, DC::Main ) << "Data is unchanged since the last checks, skipping them";
+    } else {
+        check_consistency( ui );
+        if( get_option<bool>( "SKIP_UNCHANGED_DATA_CHECKS" ) && !debug_has_error_been_observed() ) {
+            write_to_file( checked_fingerprint_path(), [&]( std::ostream & fout ) {
+                fout << fingerprint_str;
+            }, _( "data check results" ) );
+        }
+    }
+    times.checking += std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                      finalized_at ).count();
     finalized = true;
+
+    DebugLog( DL::Info, DC::Main ) << string_format(
+                                       "Data loaded: %.2fs reading, %.2fs loading, %.2fs finalizing, "
+                                       "%.2fs checking", times.reading, times.loading, times.finalizing,
+                                       times.checking );
 }
 
 void DynamicDataLoader::check_consistency( loading_ui &ui )
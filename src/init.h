@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_INIT_H
 #define CATA_SRC_INIT_H
 
+#include <cstddef>
 #include <functional>
 #include <list>
 #include <map>
@@ -66,8 +67,22 @@ class DynamicDataLoader
          */
         using deferred_json = std::list<std::pair<json_source_location, std::string>>;
 
+        /** Time spent in the loading phases since the last @ref unload_data, in seconds. */
+        struct phase_times {
+            /** Reading the json files into memory. */
+            double reading = 0.0;
+            /** Parsing them and handing the objects to the type loaders. */
+            double loading = 0.0;
+            /** @ref finalize_loaded_data, without the consistency checks. */
+            double finalizing = 0.0;
+            double checking = 0.0;
+        };
+
     private:
         bool finalized = false;
+        phase_times times;
+        /** Hash of the names and contents of all files loaded since the last @ref unload_data. */
+        std::size_t data_fingerprint = 0;
 
         struct cached_streams;
         std::unique_ptr<cached_streams> stream_cache;
@@ -148,11 +163,13 @@ class DynamicDataLoader
          * It also checks the consistency of the loaded data with
          * @ref check_consistency
          * @param ui Finalization status display.
+         * @param force_checks Check the data even if it didn't change since it last passed
+         * the checks, see the SKIP_UNCHANGED_DATA_CHECKS option.
          * @throw std::exception if the loaded data is not valid. The
          * game should *not* proceed in that case.
          */
         /*@{*/
-        void finalize_loaded_data( loading_ui &ui );
+        void finalize_loaded_data( loading_ui &ui, bool force_checks = false );
         void finalize_loaded_data();
         /*@}*/
 
@@ -168,6 +185,10 @@ class DynamicDataLoader
             return finalized;
         }
 
+        const phase_times &get_phase_times() const {
+            return times;
+        }
+
         /**
          * Get a possibly cached stream for deferred data loading. If the cached
          * stream is still in use by outside code, this returns a new stream to
@@ -653,7 +653,7 @@ item_location::operator bool() const
 
 item &item_location::operator*()
 {
-    return *ptr->target();
+    return *get_item();
 }
 
 const item &item_location::operator*() const
@@ -663,7 +663,7 @@ const item &item_location::operator*() const
 
 item *item_location::operator->()
 {
-    return ptr->target();
+    return get_item();
 }
 
 const item *item_location::operator->() const
@@ -767,6 +767,10 @@ void item_location::remove_item()
 
 item *item_location::get_item()
 {
+    if( ptr->where() != type::character ) {
+        // The item may be changed through the returned pointer.
+        map::resource_changes++;
+    }
     return ptr->target();
 }
 
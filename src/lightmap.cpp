@@ -1,6 +1,8 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
+#include <bitset>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -568,12 +570,16 @@ void map::generate_lightmap( const int zlev )
       This may seem like extra work, but take a 12x12 raging inferno:
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
+      Their light is kept between updates, only the parts that changed get cast again.
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    update_light_source_layer( zlev );
+    const auto &source_lm = map_cache.light_sources->lm;
+    for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+            if( light_source_buffer[x][y] > 0.0f ) {
+                sm[x][y] = std::max( sm[x][y], light_source_buffer[x][y] );
+            }
+            lm[x][y] = elementwise_max( lm[x][y], source_lm[x][y] );
         }
     }
     for( const std::pair<tripoint, float> &elem : lm_override ) {
@@ -862,6 +868,8 @@ void cast_zlight_segment(
         delta.y = distance;
         bool started_block = false;
         T current_transparency = 0.0f;
+        // As in castLight below, the intensity only changes with the distance within a row.
+        int last_dist = -1;
 
         // TODO: Precalculate min/max delta.z based on start/end and distance
         for( delta.z = 0; delta.z <= std::min( fov_3d_z_range, distance ); delta.z++ ) {
@@ -918,7 +926,10 @@ void cast_zlight_segment(
                 }
 
                 const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                last_intensity = calc( numerator, cumulative_transparency, dist );
+                if( dist != last_dist ) {
+                    last_intensity = calc( numerator, cumulative_transparency, dist );
+                    last_dist = dist;
+                }
 
                 if( check_blocked( current ) ) {
                     vehicle_blocked = true;
@@ -1158,6 +1169,10 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         delta.y = -distance;
         bool started_row = false;
         T current_transparency = 0.0;
+        // The cumulative transparency is fixed for the whole row, so the intensity only changes
+        // with the distance. That is the same for the whole row unless trigdist is on, so calc
+        // (and the exp in it) runs about once per row instead of once per tile.
+        int last_dist = -1;
         float away = start - ( -distance + 0.5f ) / ( -distance -
                      0.5f ); //The distance between our first leadingEdge and start
 
@@ -1185,7 +1200,10 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
             }
 
             const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
+            if( dist != last_dist ) {
+                last_intensity = calc( numerator, cumulative_transparency, dist );
+                last_dist = dist;
+            }
 
             T new_transparency = input_array[ current.x ][ current.y ];
 
@@ -1397,6 +1415,34 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
     }
 }
 
+bool map::sees_with_fov( const tripoint &F, const tripoint &T, const int range ) const
+{
+    if( ( range >= 0 && range < rl_dist( F, T ) ) || !inbounds( T ) || !inbounds( F ) ) {
+        return false;
+    }
+    const fov_cache::bitmap *found = creature_fov_cache.find( F, to_turn<int>( calendar::turn ) );
+    if( found == nullptr ) {
+        const level_cache &map_cache = get_cache_ref( F.z );
+        float ( &seen )[MAPSIZE_X][MAPSIZE_Y] = creature_fov_cache.scratch();
+        std::uninitialized_fill_n( &seen[0][0], MAPSIZE_X * MAPSIZE_Y,
+                                   static_cast<float>( LIGHT_TRANSPARENCY_SOLID ) );
+        seen[F.x][F.y] = VISIBILITY_FULL;
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            seen, map_cache.transparency_cache, map_cache.vehicle_obscured_cache, F.xy() );
+
+        fov_cache::bitmap &fov = creature_fov_cache.insert( F );
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                if( seen[x][y] > LIGHT_TRANSPARENCY_SOLID ) {
+                    fov.set( x * MAPSIZE_Y + y );
+                }
+            }
+        }
+        found = &fov;
+    }
+    return found->test( T.x * MAPSIZE_Y + T.y );
+}
+
 //Schraudolph's algorithm with John's constants
 static inline
 float fastexp( float x )
@@ -1427,22 +1473,14 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+// Casts the light of a source at p2 into lm, except into the directions covered by the bulk
+// light sources next to it.
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                               const point &p2, float luminance )
 {
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
-
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
     if( luminance <= lit_level::LOW ) {
         return;
     } else if( luminance <= lit_level::BRIGHT_ONLY ) {
@@ -1508,6 +1546,173 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    const point p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        cache.lm[p2.x][p2.y] = elementwise_max( cache.lm[p2.x][p2.y], min_light );
+        cache.sm[p2.x][p2.y] = std::max( cache.sm[p2.x][p2.y], luminance );
+    }
+    cast_light_source( cache.lm, cache.transparency_cache, cache.vehicle_obscured_cache,
+                       cache.light_source_buffer, p2, luminance );
+}
+
+// How far from its tile a light source cast by cast_light_source can change the lightmap,
+// given the lowest transparency its light might pass through.
+static int light_source_reach( float luminance, const float transparency )
+{
+    if( luminance <= lit_level::LOW ) {
+        return 0;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+    // castLight stops after the first row that is too dark.
+    int distance = 1;
+    while( distance < 60 && light_calc( luminance, transparency, distance ) > LIGHT_AMBIENT_LOW ) {
+        distance++;
+    }
+    // Plus the diagonal blocks looked up next to the lit tiles.
+    return distance + 1;
+}
+
+void map::update_light_source_layer( const int zlev )
+{
+    auto &map_cache = get_cache( zlev );
+    const auto &light_source_buffer = map_cache.light_source_buffer;
+    const auto &transparency_cache = map_cache.transparency_cache;
+    const auto &blocked_cache = map_cache.vehicle_obscured_cache;
+
+    const bool relight_all = !map_cache.light_sources;
+    if( relight_all ) {
+        map_cache.light_sources = std::make_unique<light_source_layer>();
+    }
+    light_source_layer &layer = *map_cache.light_sources;
+
+    // Submaps (indexed like transparency_cache_dirty) whose transparency changed since the layer
+    // was cast, and tiles whose light source changed.
+    std::bitset<MAPSIZE *MAPSIZE> changed_transparency;
+    std::vector<point> changed_sources;
+    float min_transparency = LIGHT_TRANSPARENCY_OPEN_AIR;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const float transparency = transparency_cache[x][y];
+            if( transparency > LIGHT_TRANSPARENCY_SOLID ) {
+                min_transparency = std::min( min_transparency, transparency );
+            }
+            if( transparency != layer.transparency[x][y] ||
+                blocked_cache[x][y].nw != layer.blocked[x][y].nw ||
+                blocked_cache[x][y].ne != layer.blocked[x][y].ne ) {
+                changed_transparency.set( ( x / SEEX ) * MAPSIZE + y / SEEY );
+            }
+            if( light_source_buffer[x][y] != layer.sources[x][y] ) {
+                changed_sources.emplace_back( x, y );
+            }
+        }
+    }
+    if( !relight_all && changed_sources.empty() && changed_transparency.none() ) {
+        return;
+    }
+
+    const float reach_transparency = relight_all ? min_transparency :
+                                     std::min( min_transparency, layer.min_transparency );
+    // Calls f with the index of every submap the light of a source at p may reach, until f
+    // returns true.
+    const auto for_each_reached_submap = [reach_transparency]( const point & p,
+    const float luminance, const auto & f ) {
+        const int reach = light_source_reach( luminance, reach_transparency );
+        const point min( std::max( p.x - reach, 0 ) / SEEX, std::max( p.y - reach, 0 ) / SEEY );
+        const point max( std::min( p.x + reach, MAPSIZE_X - 1 ) / SEEX,
+                         std::min( p.y + reach, MAPSIZE_Y - 1 ) / SEEY );
+        for( int smx = min.x; smx <= max.x; ++smx ) {
+            for( int smy = min.y; smy <= max.y; ++smy ) {
+                if( f( smx * MAPSIZE + smy ) ) {
+                    return;
+                }
+            }
+        }
+    };
+    const auto reaches = [&]( const point & p, const float luminance,
+    const std::bitset<MAPSIZE *MAPSIZE> &submaps ) {
+        bool result = false;
+        for_each_reached_submap( p, luminance, [&]( const size_t index ) {
+            result = submaps[index];
+            return result;
+        } );
+        return result;
+    };
+
+    // Submaps to cast again: everywhere the old or the new light of a changed source reaches.
+    std::bitset<MAPSIZE *MAPSIZE> dirty;
+    const auto mark_dirty = [&]( const point & p ) {
+        const float luminance = std::max( layer.sources[p.x][p.y], light_source_buffer[p.x][p.y] );
+        if( luminance > 0.0f ) {
+            for_each_reached_submap( p, luminance, [&dirty]( const size_t index ) {
+                dirty.set( index );
+                return false;
+            } );
+        }
+    };
+    if( relight_all ) {
+        dirty.set();
+    } else {
+        for( const point &p : changed_sources ) {
+            mark_dirty( p );
+            // Neighboring sources skip the directions this one covers, see cast_light_source.
+            for( const point &d : four_adjacent_offsets ) {
+                const point neighbor = p + d;
+                if( lightmap_boundaries.contains( neighbor ) ) {
+                    mark_dirty( neighbor );
+                }
+            }
+        }
+        if( changed_transparency.any() ) {
+            for( int x = 0; x < MAPSIZE_X; ++x ) {
+                for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                    const point p( x, y );
+                    const float luminance = std::max( layer.sources[x][y],
+                                                      light_source_buffer[x][y] );
+                    if( luminance > 0.0f && reaches( p, luminance, changed_transparency ) ) {
+                        mark_dirty( p );
+                    }
+                }
+            }
+        }
+    }
+
+    constexpr four_quadrants four_zeros( 0.0f );
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            if( !dirty[smx * MAPSIZE + smy] ) {
+                continue;
+            }
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                std::fill_n( &layer.lm[x][smy * SEEY], SEEY, four_zeros );
+            }
+        }
+    }
+    // Sources that didn't change and reach into the dirty submaps from outside cast the same light
+    // as before, so it doesn't matter that they also get cast into submaps that aren't dirty.
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const float luminance = light_source_buffer[x][y];
+            if( luminance > 0.0f && reaches( point( x, y ), luminance, dirty ) ) {
+                const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+                layer.lm[x][y] = elementwise_max( layer.lm[x][y], min_light );
+                cast_light_source( layer.lm, transparency_cache, blocked_cache, light_source_buffer,
+                                   point( x, y ), luminance );
+            }
+        }
+    }
+
+    std::copy_n( &light_source_buffer[0][0], MAPSIZE_X * MAPSIZE_Y, &layer.sources[0][0] );
+    std::copy_n( &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y, &layer.transparency[0][0] );
+    std::copy_n( &blocked_cache[0][0], MAPSIZE_X * MAPSIZE_Y, &layer.blocked[0][0] );
+    layer.min_transparency = min_transparency;
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
@@ -0,0 +1,70 @@
+#include "los_cache.h"
+
+#include <algorithm>
+
+#include "game_constants.h"
+#include "point.h"
+
+static constexpr uint64_t visible_bit = uint64_t( 1 ) << 63;
+static constexpr size_t capacity = los_cache::max_size * 2;
+
+uint64_t los_cache::make_key( const tripoint &from, const tripoint &to )
+{
+    // Canonicalize the order of the tripoints so the cache is reflexive.
+    const tripoint &min = from < to ? from : to;
+    const tripoint &max = from < to ? to : from;
+    const auto pack = []( const tripoint & p ) {
+        return static_cast<uint64_t>( ( p.x & 0xFF ) << 16 | ( p.y & 0xFF ) << 8 |
+                                      ( ( p.z + OVERMAP_DEPTH ) & 0xFF ) );
+    };
+    return pack( min ) << 24 | pack( max );
+}
+
+size_t los_cache::find_slot( const uint64_t key ) const
+{
+    // Fibonacci hashing, capacity is a power of 2
+    size_t index = static_cast<size_t>( ( key * 0x9E3779B97F4A7C15ULL ) >> 47 ) & ( capacity - 1 );
+    while( slots[index].generation == generation && ( slots[index].data & ~visible_bit ) != key ) {
+        index = ( index + 1 ) & ( capacity - 1 );
+    }
+    return index;
+}
+
+int los_cache::get( const tripoint &from, const tripoint &to ) const
+{
+    if( slots.empty() ) {
+        return -1;
+    }
+    const slot &found = slots[find_slot( make_key( from, to ) )];
+    if( found.generation != generation ) {
+        return -1;
+    }
+    return ( found.data & visible_bit ) ? 1 : 0;
+}
+
+void los_cache::insert( const tripoint &from, const tripoint &to, const bool visible )
+{
+    if( slots.empty() ) {
+        slots.resize( capacity );
+    } else if( used >= max_size ) {
+        clear();
+    }
+    const uint64_t key = make_key( from, to );
+    slot &found = slots[find_slot( key )];
+    if( found.generation != generation ) {
+        used++;
+        found.generation = generation;
+    }
+    found.data = visible ? key | visible_bit : key;
+}
+
+void los_cache::clear()
+{
+    used = 0;
+    generation++;
+    if( generation == 0 ) {
+        // Wrapped around, old stamps could look current
+        std::fill( slots.begin(), slots.end(), slot() );
+        generation = 1;
+    }
+}
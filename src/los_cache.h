@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CATA_SRC_LOS_CACHE_H
+#define CATA_SRC_LOS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct tripoint;
+
+/**
+ * Line of sight results between pairs of tiles, symmetric in the order of the tiles.
+ *
+ * Open addressed hash table with linear probing, allocated once on first insertion.
+ * Every slot is stamped with the generation it was written in, so clearing only bumps the
+ * generation. Once the table gets too full, it's cleared instead of evicting single entries.
+ */
+class los_cache
+{
+    public:
+        /** 1 if visible, 0 if not, -1 if not cached. */
+        int get( const tripoint &from, const tripoint &to ) const;
+        void insert( const tripoint &from, const tripoint &to, bool visible );
+        void clear();
+
+        /** Number of results currently stored. */
+        int size() const {
+            return used;
+        }
+        /** Results stored before the cache clears itself. */
+        static constexpr int max_size = 1 << 16;
+
+    private:
+        struct slot {
+            // Both tiles packed, see make_key, plus visibility in the highest bit
+            uint64_t data = 0;
+            uint32_t generation = 0;
+        };
+
+        static uint64_t make_key( const tripoint &from, const tripoint &to );
+        size_t find_slot( uint64_t key ) const;
+
+        // Twice max_size, so probe sequences stay short
+        std::vector<slot> slots;
+        // Slots from any other generation are empty, so this is never 0
+        uint32_t generation = 1;
+        int used = 0;
+};
+
+#endif // CATA_SRC_LOS_CACHE_H
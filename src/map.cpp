@@ -139,6 +139,8 @@ static cata::colony<item> nulitems;          // Returned when &i_at() is asked f
 static field              nulfield;          // Returned when &field_at() is asked for an OOB value
 static level_cache        nullcache;         // Dummy cache for z-levels outside bounds
 
+std::uint64_t map::resource_changes = 0;
+
 map &get_map()
 {
     return g->m;
@@ -280,9 +282,11 @@ void map::add_vehicle_to_cache( vehicle *veh )
         level_cache &ch = get_cache( p.z );
         ch.veh_in_active_range = true;
         ch.veh_cached_parts[p] = std::make_pair( veh,  static_cast<int>( vpr.part_index() ) );
-        if( inbounds( p ) ) {
+        if( inbounds( p ) && !ch.veh_exists_at[p.x][p.y] ) {
             ch.veh_exists_at[p.x][p.y] = true;
+            ch.veh_exists_count++;
         }
+        set_pathfinding_cache_dirty( p );
     }
 
     last_full_vehicle_list_dirty = true;
@@ -296,13 +300,15 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
     }
 
     level_cache &ch = get_cache( pt.z );
-    if( inbounds( pt ) ) {
+    if( inbounds( pt ) && ch.veh_exists_at[pt.x][pt.y] ) {
         ch.veh_exists_at[pt.x][pt.y] = false;
+        ch.veh_exists_count--;
     }
     auto it = ch.veh_cached_parts.find( pt );
     if( it != ch.veh_cached_parts.end() && it->second.first == veh ) {
         ch.veh_cached_parts.erase( it );
     }
+    set_pathfinding_cache_dirty( pt );
 
 }
 
@@ -315,9 +321,11 @@ void map::clear_vehicle_cache( )
         while( !ch.veh_cached_parts.empty() ) {
             const auto part = ch.veh_cached_parts.begin();
             const auto &p = part->first;
-            if( inbounds( p ) ) {
+            if( inbounds( p ) && ch.veh_exists_at[p.x][p.y] ) {
                 ch.veh_exists_at[p.x][p.y] = false;
+                ch.veh_exists_count--;
             }
+            set_pathfinding_cache_dirty( p );
             ch.veh_cached_parts.erase( part );
         }
         ch.veh_in_active_range = false;
@@ -404,7 +412,8 @@ void map::on_vehicle_moved( const int smz )
     set_transparency_cache_dirty( smz );
     set_floor_cache_dirty( smz );
     set_floor_cache_dirty( smz + 1 );
-    set_pathfinding_cache_dirty( smz );
+    // The pathfinding cache was told about every tile the vehicle left and entered when the
+    // vehicle cache got updated
 }
 
 void map::vehmove()
@@ -434,12 +443,12 @@ void map::vehmove()
     // Process item removal on the vehicles that were modified this turn.
     // Use a copy because part_removal_cleanup can modify the container.
     auto temp = dirty_vehicle_list;
+    std::set<vehicle *> turn_vehicles;
+    for( const wrapped_vehicle &w : vehicle_list ) {
+        turn_vehicles.insert( w.v );
+    }
     for( const auto &elem : temp ) {
-        auto same_ptr = [ elem ]( const struct wrapped_vehicle & tgt ) {
-            return elem == tgt.v;
-        };
-        if( std::find_if( vehicle_list.begin(), vehicle_list.end(), same_ptr ) !=
-            vehicle_list.end() ) {
+        if( turn_vehicles.count( elem ) != 0 ) {
             elem->part_removal_cleanup();
         }
     }
@@ -493,13 +502,7 @@ bool map::vehproceed( VehicleList &vehicle_list )
         level_cache &cache = get_cache( zlev );
 
         // Check if any vehicles exist in the active range for this z-level
-        cache.veh_in_active_range = cache.veh_in_active_range &&
-                                    std::any_of( std::begin( cache.veh_exists_at ),
-        std::end( cache.veh_exists_at ), []( const auto & row ) {
-            return std::any_of( std::begin( row ), std::end( row ), []( bool veh_exists ) {
-                return veh_exists;
-            } );
-        } );
+        cache.veh_in_active_range = cache.veh_in_active_range && cache.veh_exists_count > 0;
     }
 
     return true;
@@ -1036,6 +1039,20 @@ const vehicle *map::veh_at_internal( const tripoint &p, int &part_num ) const
     return nullptr;
 }
 
+const vehicle *map::veh_at_internal_quiet( const tripoint &p, int &part_num ) const
+{
+    const level_cache &ch = get_cache( p.z );
+    if( ch.veh_in_active_range && ch.veh_exists_at[p.x][p.y] ) {
+        const auto it = ch.veh_cached_parts.find( p );
+        if( it != ch.veh_cached_parts.end() ) {
+            part_num = it->second.second;
+            return it->second.first;
+        }
+    }
+    part_num = -1;
+    return nullptr;
+}
+
 vehicle *map::veh_at_internal( const tripoint &p, int &part_num )
 {
     return const_cast<vehicle *>( const_cast<const map *>( this )->veh_at_internal( p, part_num ) );
@@ -1245,12 +1262,8 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
         // that z-level
         if( src.z != dst.z ) {
             level_cache &ch2 = get_cache( src.z );
-            for( const vehicle *elem : ch2.vehicle_list ) {
-                if( elem == &veh ) {
-                    ch2.vehicle_list.erase( &veh );
-                    ch2.zone_vehicles.erase( &veh );
-                    break;
-                }
+            if( ch2.vehicle_list.erase( &veh ) != 0 ) {
+                ch2.zone_vehicles.erase( &veh );
             }
         }
         veh.check_is_heli_landed();
@@ -1368,6 +1381,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     }
 
     current_submap->set_furn( l, new_furniture );
+    resource_changes++;
 
     // Set the dirty flags
     const furn_t &old_t = old_id.obj();
@@ -1411,7 +1425,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1512,7 +1526,7 @@ uint8_t map::get_known_connections( const tripoint &p, int connect_group,
     if( use_tiles ) {
         is_memorized =
         [&]( const tripoint & q ) {
-            return !g->u.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !g->u.get_memorized_tile( getabs( q ) ).tile().empty();
         };
     } else {
 #endif
@@ -1646,6 +1660,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     }
 
     current_submap->set_ter( l, new_terrain );
+    resource_changes++;
 
     // Set the dirty flags
     const ter_t &old_t = old_id.obj();
@@ -1692,7 +1707,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -4091,6 +4106,7 @@ map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it
     }
 
     current_submap->update_lum_rem( l, *it );
+    resource_changes++;
 
     return current_submap->get_items( l ).erase( it );
 }
@@ -4119,6 +4135,7 @@ void map::i_clear( const tripoint &p )
 
     current_submap->set_lum( l, 0 );
     current_submap->get_items( l ).clear();
+    resource_changes++;
 }
 
 item &map::spawn_an_item( const tripoint &p, item new_item,
@@ -4246,6 +4263,7 @@ item &map::add_item_or_charges( const tripoint &pos, item obj, bool overflow )
         {
             for( auto &e : i_at( tile ) ) {
                 if( e.merge_charges( obj ) ) {
+                    resource_changes++;
                     return e;
                 }
             }
@@ -4352,6 +4370,7 @@ item &map::add_item( const tripoint &p, item new_item )
     current_submap->update_lum_add( l, new_item );
 
     const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
+    resource_changes++;
     if( new_item.needs_processing() ) {
         if( current_submap->active_items.empty() ) {
             submaps_with_active_items.insert( tripoint( abs_sub.x + p.x / SEEX, abs_sub.y + p.y / SEEY, p.z ) );
@@ -4799,6 +4818,7 @@ std::list<item> map::use_amount_square( const tripoint &p, const itype_id &type,
 std::list<item> map::use_amount( const tripoint &origin, const int range, const itype_id &type,
                                  int &quantity, const std::function<bool( const item & )> &filter )
 {
+    resource_changes++;
     std::list<item> ret;
     for( int radius = 0; radius <= range && quantity > 0; radius++ ) {
         for( const tripoint &p : points_in_radius( origin, radius ) ) {
@@ -4896,6 +4916,7 @@ std::list<item> map::use_charges( const tripoint &origin, const int range,
                                   const itype_id &type, int &quantity,
                                   const std::function<bool( const item & )> &filter, basecamp *bcp )
 {
+    resource_changes++;
     std::list<item> ret;
 
     // populate a grid of spots that can be reached
@@ -5188,6 +5209,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5264,6 +5286,7 @@ void map::remove_trap( const tripoint &p )
         }
 
         current_submap->set_trap( l, tr_null );
+        set_pathfinding_cache_dirty( p );
         auto &traps = traplocs[tid.to_i()];
         const auto iter = std::find( traps.begin(), traps.end(), p );
         if( iter != traps.end() ) {
@@ -5407,6 +5430,8 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     invalidate_max_populated_zlev( p.z );
 
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
+        current_submap->mark_field_active( l );
+        resource_changes++;
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -5429,7 +5454,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5450,6 +5475,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
     submap *const current_submap = get_submap_at( p, l );
 
     if( current_submap->get_field( l ).remove_field( field_to_remove ) ) {
+        resource_changes++;
         // Only adjust the count if the field actually existed.
         if( !--current_submap->field_count ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -5461,7 +5487,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -6126,15 +6152,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
-    char cached = skew_vision_cache.get( key, -1 );
+    const int cached = skew_vision_cache.get( F, T );
     if( cached >= 0 ) {
         return cached > 0;
     }
@@ -6159,7 +6177,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        skew_vision_cache.insert( F, T, visible );
         return visible;
     }
 
@@ -6192,7 +6210,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    skew_vision_cache.insert( F, T, visible );
     return visible;
 }
 
@@ -6477,7 +6495,7 @@ bool map::obstructed_by_vehicle_rotation( const tripoint &from, const tripoint &
 
     point delta = to.xy() - from.xy();
 
-    auto cache = get_cache( from.z ).vehicle_obstructed_cache;
+    const auto &cache = get_cache( from.z ).vehicle_obstructed_cache;
 
     if( delta == point_north_west ) {
         return cache[from.x][from.y].nw;
@@ -6732,14 +6750,9 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
     update_vehicle_list( dst_submap, dst.z );
 
     level_cache &ch = get_cache( src.z );
-    for( const vehicle *elem : ch.vehicle_list ) {
-        if( elem == &veh ) {
-            ch.vehicle_list.erase( &veh );
-            ch.zone_vehicles.erase( &veh );
-            break;
-        }
+    if( ch.vehicle_list.erase( &veh ) != 0 ) {
+        ch.zone_vehicles.erase( &veh );
     }
-
 }
 
 void map::shift( const point &sp )
@@ -6922,6 +6935,7 @@ void map::saven( const tripoint &grid )
     }
 
     submap_to_save->last_touched = calendar::turn;
+    submap_to_save->dirty = true;
     MAPBUFFER.add_submap( abs, submap_to_save );
 }
 
@@ -6995,6 +7009,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     set_pathfinding_cache_dirty( grid.z );
     set_suspension_cache_dirty( grid.z );
     setsubmap( gridn, tmpsub );
+    tmpsub->dirty = true;
     if( !tmpsub->active_items.empty() ) {
         submaps_with_active_items.emplace( grid_abs_sub );
     }
@@ -8196,6 +8211,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
 
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
+        creature_fov_cache.clear();
     }
     // Initial value is illegal player position.
     const tripoint &p = g->u.pos();
@@ -8698,11 +8714,14 @@ level_cache::level_cache()
     std::fill_n( &visibility_cache[0][0], map_dimensions, lit_level::DARK );
     veh_in_active_range = false;
     std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
+    veh_exists_count = 0;
 }
 
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    dirty_submaps.set();
+    portals_dirty.set();
 }
 
 pathfinding_cache::~pathfinding_cache() = default;
@@ -8714,8 +8733,43 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
-    if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+    if( !inbounds_z( zlev ) ) {
+        return;
+    }
+    auto &cache = get_pathfinding_cache( zlev );
+    cache.dirty = true;
+    cache.version++;
+    cache.dirty_submaps.set();
+    // Stairs link portals to the levels above and below
+    for( int z = zlev - 1; z <= zlev + 1; z++ ) {
+        if( inbounds_z( z ) ) {
+            get_pathfinding_cache( z ).portals_dirty.set();
+        }
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    const tripoint smp = ms_to_sm_copy( p );
+    auto &cache = get_pathfinding_cache( smp.z );
+    cache.dirty = true;
+    cache.version++;
+    cache.dirty_submaps.set( smp.x * MAPSIZE + smp.y );
+    // Portals on shared borders belong to both submaps, and stairs can lead anywhere
+    // within the overmap tile on the levels above and below
+    for( int z = smp.z - 1; z <= smp.z + 1; z++ ) {
+        if( !inbounds_z( z ) ) {
+            continue;
+        }
+        auto &portals_dirty = get_pathfinding_cache( z ).portals_dirty;
+        for( int x = std::max( smp.x - 1, 0 ); x <= std::min( smp.x + 1, my_MAPSIZE - 1 ); x++ ) {
+            for( int y = std::max( smp.y - 1, 0 ); y <= std::min( smp.y + 1, my_MAPSIZE - 1 ); y++ ) {
+                portals_dirty.set( x * MAPSIZE + y );
+            }
+        }
     }
 }
 
@@ -8740,10 +8794,16 @@ void map::update_pathfinding_cache( int zlev ) const
         return;
     }
 
-    std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    if( cache.dirty_submaps.all() ) {
+        std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+        std::uninitialized_fill_n( &cache.walk_cost[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
+    }
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !cache.dirty_submaps[smx * MAPSIZE + smy] ) {
+                continue;
+            }
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
             if( !cur_submap ) {
                 return;
@@ -8766,13 +8826,26 @@ void map::update_pathfinding_cache( int zlev ) const
                     const vehicle *veh = veh_at_internal( p, part );
 
                     const int cost = move_cost_internal( furniture, terrain, veh, part );
+                    int walk_cost = cost;
 
                     if( cost > 2 ) {
                         cur_value |= PF_SLOW;
                     } else if( cost <= 0 ) {
                         cur_value |= PF_WALL;
+                        walk_cost = 0;
                         if( terrain.has_flag( TFLAG_CLIMBABLE ) ) {
                             cur_value |= PF_CLIMBABLE;
+                            walk_cost = 5;
+                        }
+                        if( terrain.open || furniture.open ) {
+                            // Doors, same cost as map::route gives them
+                            walk_cost = 4;
+                        } else if( veh != nullptr ) {
+                            const cata::optional<vpart_reference> obstacle = vpart_position(
+                                        const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+                            if( obstacle && obstacle->has_feature( VPFLAG_OPENABLE ) ) {
+                                walk_cost = 10;
+                            }
                         }
                     }
 
@@ -8804,8 +8877,10 @@ void map::update_pathfinding_cache( int zlev ) const
                     }
 
                     cache.special[p.x][p.y] = cur_value;
+                    cache.walk_cost[p.x][p.y] = std::min( walk_cost, 255 );
                 }
             }
+            cache.dirty_submaps.reset( smx * MAPSIZE + smy );
         }
     }
 
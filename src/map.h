@@ -24,12 +24,13 @@
 #include "coordinates.h"
 #include "enums.h"
 #include "filter_utils.h"
+#include "fov_cache.h"
 #include "game_constants.h"
 #include "item.h"
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
+#include "los_cache.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "point.h"
@@ -86,6 +87,10 @@ using VehicleList = std::vector<wrapped_vehicle>;
 class map;
 
 enum ter_bitflags : int;
+struct flow_field;
+struct pathfinder;
+struct route_step;
+struct pathfinding_arena;
 struct pathfinding_cache;
 struct pathfinding_settings;
 template<typename T>
@@ -294,6 +299,22 @@ struct diagonal_blocks {
     bool ne;
 };
 
+/**
+ * The light cast by the bulk light sources of a z-level (see level_cache::light_source_buffer),
+ * kept between lightmap updates. Only the submaps around light sources that changed, or around
+ * tiles whose transparency changed, get cast again.
+ */
+struct light_source_layer {
+    /** What the layer was cast from, compared against the current caches to find changes. */
+    float sources[MAPSIZE_X][MAPSIZE_Y];
+    float transparency[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks blocked[MAPSIZE_X][MAPSIZE_Y];
+    /** Lowest non-solid transparency of the above, which limits how far the light reaches. */
+    float min_transparency;
+
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
@@ -312,6 +333,8 @@ struct level_cache {
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Allocated by the first lightmap update of the z-level
+    std::unique_ptr<light_source_layer> light_sources;
 
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
@@ -354,6 +377,8 @@ struct level_cache {
 
     bool veh_in_active_range;
     bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
+    // Number of true entries in veh_exists_at.
+    int veh_exists_count;
     std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
@@ -459,6 +484,9 @@ class map
         }
 
         void set_pathfinding_cache_dirty( int zlev );
+        // more granular version, only the submap containing p gets recalculated
+        // p is in local coords ("ms")
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p ) {
@@ -519,7 +547,7 @@ class map
 
         // See field.cpp
         std::tuple<maptile, maptile, maptile> get_wind_blockers( const int &winddirection,
-                const tripoint &pos );
+                const tripoint &pos ) const;
 
         /** Draw a visible part of the map into `w`.
          *
@@ -595,8 +623,38 @@ class map
         std::array<std::pair<tripoint, maptile>, 8> get_neighbors( const tripoint &p );
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                          const time_duration &outdoor_age_speedup, scent_block &sblk );
+        /** The part of @ref spread_gas that only affects the gas' own tile. */
+        void age_and_neutralize_gas( field_entry &cur, const tripoint &p,
+                                     const time_duration &outdoor_age_speedup, scent_block &sblk );
+        /** Gas moving to a neighboring tile, see @ref plan_gases_from_snapshot. */
+        struct gas_transfer {
+            tripoint src;
+            tripoint dst;
+            field_type_id type;
+        };
+        /**
+         * Decides where the gases of all submaps with fields on z-levels @p minz to @p maxz go,
+         * see the SNAPSHOT_GAS_SPREAD option. Where each gas goes is decided from the fields as
+         * they were before any of them moved, so the submaps of all z-levels are planned on one
+         * set of worker threads.
+         * @return The moves on each z-level, starting with @p minz, in a fixed order.
+         */
+        std::vector<std::vector<gas_transfer>> plan_gases_from_snapshot( int minz, int maxz );
+        /**
+         * Applies moves planned by @ref plan_gases_from_snapshot, skipping gases that are gone
+         * or got too thin to spread.
+         */
+        void spread_gases_from_snapshot( const std::vector<gas_transfer> &transfers );
+        /**
+         * Appends the moves of the gases in the submap to @p transfers. Only reads the map, never
+         * reports errors, and uses random numbers derived from the turn and the tile instead of
+         * @ref rng, so it's safe to call off the main thread.
+         */
+        void plan_gas_spread( const tripoint &submap_pos, const oter_id &om_ter,
+                              std::vector<gas_transfer> &transfers ) const;
         void create_hot_air( const tripoint &p, int intensity );
-        bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
+        bool gas_can_spread_to( const field_entry &cur, const tripoint &src,
+                                const tripoint &dst ) const;
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
         int burn_body_part( player &u, field_entry &cur, body_part bp, int scale );
     public:
@@ -669,6 +727,12 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Same as @ref sees, but tests a bit in a shadowcast field of view from `F`, computed
+         * on first use each turn and shared by everything looking from there.
+         * `T` must be on the same z-level as `F`.
+         */
+        bool sees_with_fov( const tripoint &F, const tripoint &T, int range ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -757,6 +821,21 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Same as @ref route without pre-closed points, for crowds heading to the same place.
+         * Once two different requesters ask for the same target with equivalent settings, their
+         * routes are read off a distance field around the target, which is kept until the
+         * target's z-level changes.
+         */
+        std::vector<tripoint> route_shared( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+                                            const Creature *requester ) const;
+        /**
+         * Up to date distance field for t, null if it isn't worth building one yet: until a
+         * second requester asks for t while the target's z-level stays unchanged.
+         */
+        const flow_field *get_flow_field( const tripoint &t, const pathfinding_settings &settings,
+                                          const Creature *requester ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -791,6 +870,11 @@ class map
         optional_vpart_position veh_at( const tripoint &p ) const;
         vehicle *veh_at_internal( const tripoint &p, int &part_num );
         const vehicle *veh_at_internal( const tripoint &p, int &part_num ) const;
+        /**
+         * Same as @ref veh_at_internal, but doesn't report an outdated vehicle cache, so it
+         * can be used off the main thread.
+         */
+        const vehicle *veh_at_internal_quiet( const tripoint &p, int &part_num ) const;
         // Put player on vehicle at x,y
         void board_vehicle( const tripoint &p, player *pl );
         // Remove given passenger from given vehicle part.
@@ -1228,6 +1312,12 @@ class map
         // Returns points for all submaps with inconsistent state relative to
         // the list in map.  Used in tests.
         std::vector<tripoint> check_submap_active_item_consistency();
+        /**
+         * Counts changes to what an @ref inventory formed from the map is made of: items,
+         * furniture, terrain, fields and vehicle contents. Shared by all map instances, so an
+         * unchanged value only tells that none of them changed anything.
+         */
+        static std::uint64_t resource_changes;
         // Accessor that returns a wrapped reference to an item stack for safe modification.
         map_stack i_at( const tripoint &p );
         map_stack i_at( const point &p ) {
@@ -1405,7 +1495,12 @@ class map
         void create_burnproducts( const tripoint &p, const item &fuel, const units::mass &burned_mass );
         // See fields.cpp
         void process_fields();
-        void process_fields_in_submap( submap *current_submap, const tripoint &submap_pos );
+        /**
+         * @param gases_spread Whether the gases have already been moved this turn by
+         * @ref spread_gases_from_snapshot.
+         */
+        void process_fields_in_submap( submap *current_submap, const tripoint &submap_pos,
+                                       bool gases_spread = false );
         /**
          * Apply field effects to the creature when it's on a square with fields.
          */
@@ -1810,6 +1905,8 @@ class map
         void update_suspension_cache( const int &z );
     protected:
         void generate_lightmap( int zlev );
+        /** Casts the changed bulk light sources into level_cache::light_sources. */
+        void update_light_source_layer( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1999,6 +2096,10 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        /**
+         * Search state reused between calls to @ref route, allocated on first use.
+         */
+        mutable std::unique_ptr<pathfinding_arena> pathfinding_state;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -2007,7 +2108,11 @@ class map
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable los_cache skew_vision_cache;
+        /**
+         * Fields of view used by @ref sees_with_fov.
+         */
+        mutable fov_cache creature_fov_cache;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
@@ -2021,6 +2126,21 @@ class map
         }
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
+        void update_submap_portals( pathfinding_cache &cache, const tripoint &grid ) const;
+        /**
+         * Tile by tile A* from f to t, through the tiles allowed by pf.
+         * Returns an empty route if there is no such path.
+         */
+        std::vector<tripoint> route_search( pathfinder &pf, const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+                                            const std::set<tripoint> &pre_closed ) const;
+        /** Straight line from f to t if it only crosses plain ground and none of pre_closed, else empty. */
+        std::vector<tripoint> straight_route( const tripoint &f, const tripoint &t,
+                                              const std::set<tripoint> &pre_closed ) const;
+        /** Cost of stepping from cur onto its neighbor p, on the same z-level. */
+        route_step get_route_step( const tripoint &cur, const vehicle *cur_veh, const tripoint &p,
+                                   const pathfinding_cache &pf_cache,
+                                   const pathfinding_settings &settings ) const;
 
         visibility_variables visibility_variables_cache;
 
@@ -2036,6 +2156,11 @@ class map
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
 
         void update_pathfinding_cache( int zlev ) const;
+        /**
+         * Recalculates portals of submaps on this z-level that changed since the last call.
+         * Also brings the pathfinding cache of the level up to date, since portals are built from it.
+         */
+        void update_portal_graph( int zlev ) const;
 
         void update_visibility_cache( int zlev );
         const visibility_variables &get_visibility_variables_cache() const;
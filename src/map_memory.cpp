@@ -1,5 +1,7 @@
 #include "map_memory.h"
 
+#include <unordered_map>
+
 #include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
 #include "debug.h"
@@ -9,7 +11,43 @@
 #include "line.h"
 #include "translations.h"
 
-const memorized_terrain_tile mm_submap::default_tile{ "", 0, 0 };
+namespace
+{
+
+/** All tile names memorized in this session, looked up by id and by name. */
+struct tile_name_table {
+    std::vector<std::string> names{ std::string() };
+    std::unordered_map<std::string, std::uint32_t> ids{ { std::string(), 0 } };
+};
+
+tile_name_table &tile_names()
+{
+    static tile_name_table table;
+    return table;
+}
+
+} // namespace
+
+memorized_terrain_tile::memorized_terrain_tile( const std::string &tile, const int subtile,
+        const int rotation ) : subtile( subtile ), rotation( rotation )
+{
+    tile_name_table &table = tile_names();
+    const auto iter = table.ids.find( tile );
+    if( iter != table.ids.end() ) {
+        tile_id = iter->second;
+    } else {
+        tile_id = table.names.size();
+        table.names.push_back( tile );
+        table.ids.emplace( tile, tile_id );
+    }
+}
+
+const std::string &memorized_terrain_tile::tile() const
+{
+    return tile_names().names[tile_id];
+}
+
+const memorized_terrain_tile mm_submap::default_tile{};
 const int mm_submap::default_symbol = 0;
 
 #define MM_SIZE (MAPSIZE * 2)
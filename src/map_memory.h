@@ -2,8 +2,10 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -12,13 +14,24 @@
 class JsonOut;
 class JsonIn;
 
+/**
+ * A memorized graphic tile. The tile name is interned: every name gets a small id the first time
+ * it's memorized, so the memory holds ids instead of a string per map square.
+ */
 struct memorized_terrain_tile {
-    std::string tile;
-    int subtile;
-    int rotation;
+    /** Id of the tile name, 0 means no tile. Only valid for the current session. */
+    std::uint32_t tile_id = 0;
+    std::int16_t subtile = 0;
+    std::int16_t rotation = 0;
+
+    memorized_terrain_tile() = default;
+    memorized_terrain_tile( const std::string &tile, int subtile, int rotation );
+
+    /** Name of the tile, empty if there is none. */
+    const std::string &tile() const;
 
     inline bool operator==( const memorized_terrain_tile &rhs ) const {
-        return ( rotation == rhs.rotation ) && ( subtile == rhs.subtile ) && ( tile == rhs.tile );
+        return rotation == rhs.rotation && subtile == rhs.subtile && tile_id == rhs.tile_id;
     }
 
     inline bool operator!=( const memorized_terrain_tile &rhs ) const {
@@ -79,8 +92,16 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( JsonIn &jsin );
+        /**
+         * The tile names are written as indices into @p names, which collects the names
+         * of a whole region. @p names_index maps tile ids to those indices.
+         */
+        void serialize( JsonOut &jsout, std::vector<std::string> &names,
+                        std::map<std::uint32_t, int> &names_index ) const;
+        /** Reads the format of @ref serialize, @p tile_ids are the ids of the region's names. */
+        void deserialize( JsonIn &jsin, const std::vector<std::uint32_t> &tile_ids );
+        /** Reads the old format, which had the tile names inline. */
+        void deserialize_legacy( JsonIn &jsin );
 
     private:
         std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "background_save.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -18,10 +19,12 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "translations.h"
 #include "ui_manager.h"
 
@@ -30,6 +33,11 @@ static std::string find_quad_path( const std::string &dirname, const tripoint &o
     return string_format( "%s/%d.%d.%d.map", dirname, om_addr.x, om_addr.y, om_addr.z );
 }
 
+static std::string find_binary_quad_path( const std::string &dirname, const tripoint &om_addr )
+{
+    return string_format( "%s/%d.%d.%d.bmap", dirname, om_addr.x, om_addr.y, om_addr.z );
+}
+
 static std::string find_dirname( const tripoint &om_addr )
 {
     const tripoint segment_addr = omt_to_seg_copy( om_addr );
@@ -110,6 +118,7 @@ void mapbuffer::save( bool delete_after_save )
     map &here = get_map();
     const tripoint map_origin = sm_to_omt_copy( here.get_abs_sub() );
     const bool map_has_zlevels = g != nullptr && here.has_zlevels();
+    const bool binary = get_option<bool>( "BINARY_MAPS" );
 
     static_popup popup;
 
@@ -143,12 +152,11 @@ void mapbuffer::save( bool delete_after_save )
         // We're breaking them into subdirectories so there aren't too many files per directory.
         // Might want to make a set for this one too so it's only checked once per save().
         const std::string dirname = find_dirname( om_addr );
-        const std::string quad_path = find_quad_path( dirname, om_addr );
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
+        save_quad( dirname, om_addr, binary, submaps_to_delete,
                    delete_after_save || zlev_del ||
                    om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
                    om_addr.x > map_origin.x + HALF_MAPSIZE ||
@@ -162,9 +170,8 @@ void mapbuffer::save( bool delete_after_save )
     get_distribution_grid_tracker().on_saved();
 }
 
-void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
-                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+void mapbuffer::save_quad( const std::string &dirname, const tripoint &om_addr, bool binary,
+                           std::list<tripoint> &submaps_to_delete, bool delete_after_save )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -174,6 +181,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     offsets.push_back( point_south_east );
 
     bool all_uniform = true;
+    bool any_dirty = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
@@ -183,10 +191,14 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && sm->dirty ) {
+            any_dirty = true;
+        }
     }
 
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
+    // Nothing to save - a uniform quad will be regenerated faster than it would be re-read,
+    // and a clean one is on disk already.
+    if( all_uniform || !any_dirty ) {
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
                 if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
@@ -198,44 +210,67 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
+    std::vector<std::pair<tripoint, const submap *>> quad;
+    for( auto &submap_addr : submap_addrs ) {
+        if( submaps.count( submap_addr ) == 0 ) {
+            continue;
+        }
 
-            submap *sm = submaps[submap_addr];
+        submap *sm = submaps[submap_addr];
 
-            if( sm == nullptr ) {
-                continue;
-            }
+        if( sm == nullptr ) {
+            continue;
+        }
 
-            jsout.start_object();
+        quad.emplace_back( submap_addr, sm );
 
-            jsout.member( "version", savegame_version );
-            jsout.member( "coordinates" );
+        if( delete_after_save ) {
+            submaps_to_delete.push_back( submap_addr );
+        }
+    }
 
+    // Don't create the directory if it would be empty
+    assure_dir_exist( dirname );
+    const std::string json_path = find_quad_path( dirname, om_addr );
+    const std::string binary_path = find_binary_quad_path( dirname, om_addr );
+    if( binary ) {
+        write_to_file( binary_path, [&]( std::ostream & fout ) {
+            submap_binary::write_quad( fout, quad );
+        } );
+    } else {
+        write_to_file( json_path, [&]( std::ostream & fout ) {
+            JsonOut jsout( fout );
             jsout.start_array();
-            jsout.write( submap_addr.x );
-            jsout.write( submap_addr.y );
-            jsout.write( submap_addr.z );
-            jsout.end_array();
+            for( const auto &elem : quad ) {
+                const tripoint &submap_addr = elem.first;
+
+                jsout.start_object();
+
+                jsout.member( "version", savegame_version );
+                jsout.member( "coordinates" );
 
-            sm->store( jsout );
+                jsout.start_array();
+                jsout.write( submap_addr.x );
+                jsout.write( submap_addr.y );
+                jsout.write( submap_addr.z );
+                jsout.end_array();
 
-            jsout.end_object();
+                elem.second->store( jsout );
 
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
+                jsout.end_object();
             }
-        }
 
-        jsout.end_array();
-    } );
+            jsout.end_array();
+        } );
+    }
+
+    // The quad in the other format is out of date now, and would shadow or be shadowed by this one.
+    background_save::remove( binary ? json_path : binary_path );
+
+    // What's on disk is up to date now.
+    for( const auto &elem : quad ) {
+        submaps[elem.first]->dirty = false;
+    }
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -245,7 +280,26 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
     const std::string dirname = find_dirname( om_addr );
+
+    // Whichever format it was saved in last, the other one doesn't exist anymore.
+    const std::string binary_path = find_binary_quad_path( dirname, om_addr );
     std::string quad_path = find_quad_path( dirname, om_addr );
+    background_save::wait_for( binary_path );
+    background_save::wait_for( quad_path );
+    if( file_exist( binary_path ) ) {
+        const bool loaded = read_from_file( binary_path, [this]( std::istream & fin ) {
+            deserialize_binary( fin );
+        } );
+        if( !loaded ) {
+            return nullptr;
+        }
+        if( submaps.count( p ) == 0 ) {
+            debugmsg( "file %s did not contain the expected submap %d,%d,%d",
+                      binary_path, p.x, p.y, p.z );
+            return nullptr;
+        }
+        return submaps[ p ];
+    }
 
     if( !file_exist( quad_path ) ) {
         // Fix for old saves where the path was generated using std::stringstream, which
@@ -293,6 +347,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                 sm->load( jsin, submap_member_name, version );
             }
         }
+        sm->dirty = false;
 
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
@@ -300,3 +355,13 @@ void mapbuffer::deserialize( JsonIn &jsin )
         }
     }
 }
+
+void mapbuffer::deserialize_binary( std::istream &fin )
+{
+    for( auto &elem : submap_binary::read_quad( fin ) ) {
+        elem.second->dirty = false;
+        if( !add_submap( elem.first, elem.second ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", elem.first.x, elem.first.y, elem.first.z );
+        }
+    }
+}
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
@@ -79,9 +80,9 @@ class mapbuffer
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
-        void save_quad( const std::string &dirname, const std::string &filename,
-                        const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+        void deserialize_binary( std::istream &fin );
+        void save_quad( const std::string &dirname, const tripoint &om_addr, bool binary,
+                        std::list<tripoint> &submaps_to_delete, bool delete_after_save );
         submap_map_t submaps;
 };
 
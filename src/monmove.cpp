@@ -10,6 +10,7 @@
 #include <list>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <unordered_map>
 
 #include "avatar.h"
@@ -313,7 +314,8 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
 
 void monster::plan()
 {
-    const auto &factions = g->critter_tracker->factions();
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const auto &factions = tracker.factions();
 
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
@@ -335,6 +337,13 @@ void monster::plan()
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
+    // Nothing further than this can be rated better than the current target.
+    // Smart ratings aren't bound by distance, only by what can be seen.
+    const int sight_limit = std::max( max_sight_range, MAX_VIEW_DISTANCE );
+    const auto search_radius = [&]() {
+        return smart_planning ? sight_limit : std::min<int>( std::ceil( dist ), sight_limit );
+    };
+
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
     if( friendly == 0 && sees( g->u ) && !has_flag( MF_PET_WONT_FOLLOW ) && !waiting ) {
         dist = rate_target( g->u, dist, smart_planning );
@@ -361,26 +370,28 @@ void monster::plan()
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
-                    // baby nearby; is the player too close?
-                    dist = tmp.rate_target( g->u, dist, smart_planning );
-                    if( dist <= 3 ) {
-                        //proximity to baby; monster gets furious and less likely to flee
-                        anger += angers_cub_threatened;
-                        morale += angers_cub_threatened / 2;
-                    }
+            const auto is_baby = [this]( const monster & tmp ) {
+                return type->baby_monster == tmp.type->id;
+            };
+            for( monster *baby : tracker.monsters_within( g->u.pos(), search_radius(), is_baby ) ) {
+                // baby nearby; is the player too close?
+                dist = baby->rate_target( g->u, dist, smart_planning );
+                if( dist <= 3 ) {
+                    //proximity to baby; monster gets furious and less likely to flee
+                    anger += angers_cub_threatened;
+                    morale += angers_cub_threatened / 2;
                 }
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &tmp;
-                    dist = rating;
-                }
+        const auto is_unfriendly = []( const monster & tmp ) {
+            return tmp.friendly == 0;
+        };
+        for( monster *tmp : tracker.monsters_within( pos(), search_radius(), is_unfriendly ) ) {
+            float rating = rate_target( *tmp, dist, smart_planning );
+            if( rating < dist ) {
+                target = tmp;
+                dist = rating;
             }
         }
     }
@@ -453,12 +464,8 @@ void monster::plan()
                 continue;
             }
 
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
+            for( monster *hostile : tracker.monsters_within( pos(), search_radius(), fac.first ) ) {
+                monster &mon = *hostile;
                 float rating = rate_target( mon, dist, smart_planning );
                 if( rating == dist ) {
                     ++valid_targets;
@@ -492,12 +499,8 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
+        for( monster *ally : tracker.monsters_within( pos(), search_radius(), actual_faction ) ) {
+            monster &mon = *ally;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -827,7 +830,10 @@ void monster::move()
             if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
                 ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
                 // We need a new path
-                path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+                // Hordes usually chase the same target, so share the search between them
+                const std::set<tripoint> avoid = get_path_avoid();
+                path = avoid.empty() ? g->m.route_shared( pos(), goal, pf_settings, this ) :
+                       g->m.route( pos(), goal, pf_settings, avoid );
             }
 
             // Try to respect old paths, even if we can't pathfind at the moment
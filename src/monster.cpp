@@ -9,6 +9,7 @@
 #include "avatar.h"
 #include "character.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "cursesdef.h"
 #include "debug.h"
 #include "effect.h"
@@ -2356,14 +2357,13 @@ void monster::die( Creature *nkiller )
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
         int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
-                continue;
-            }
-
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
+        const auto same_species = [this]( const monster & critter ) {
+            return critter.type->same_species( *type );
+        };
+        for( monster *critter : g->critter_tracker->monsters_within( pos(), light, same_species ) ) {
+            if( g->m.sees( critter->pos(), pos(), light ) ) {
+                critter->morale += morale_adjust;
+                critter->anger += anger_adjust;
             }
         }
     }
@@ -2853,14 +2853,13 @@ void monster::on_hit( Creature *source, bodypart_id,
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
         int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
-                continue;
-            }
-
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
+        const auto same_species = [this]( const monster & critter ) {
+            return critter.type->same_species( *type );
+        };
+        for( monster *critter : g->critter_tracker->monsters_within( pos(), light, same_species ) ) {
+            if( g->m.sees( critter->pos(), pos(), light ) ) {
+                critter->morale += morale_adjust;
+                critter->anger += anger_adjust;
             }
         }
     }
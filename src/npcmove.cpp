@@ -474,6 +474,10 @@ void npc::assess_danger()
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
             continue;
         }
+        // Nothing beyond the view distance can be seen or shot at, so it can't be a threat.
+        if( square_dist( pos(), critter.pos() ) > MAX_VIEW_DISTANCE ) {
+            continue;
+        }
         if( att != A_HOSTILE && ( critter.friendly || !is_enemy() ) ) {
             continue;
         }
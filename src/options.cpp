@@ -2080,6 +2080,11 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "SKIP_UNCHANGED_DATA_CHECKS", "debug", translate_marker( "Skip checks of unchanged data" ),
+         translate_marker( "If true, the consistency checks at the end of loading are skipped when the game data, the mods and the game version are the same as the last time the checks passed.  Makes loading faster, but modders should leave it off." ),
+         false
+       );
+
     add_empty_line();
 
     add_option_group( "debug", Group( "debug_log", to_translation( "Logging" ),
@@ -2168,6 +2173,11 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "MONSTER_FOV_BITMAPS", "debug", translate_marker( "Shared monster vision" ),
+         translate_marker( "If true, monsters check what they can see against a field of view calculated once per turn for the tile they stand on.  Faster with many monsters around, but can differ slightly from the line of sight checks used otherwise." ),
+         false
+       );
+
     add( "ENABLE_EVENTS", "debug", translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
@@ -2180,6 +2190,16 @@ void options_manager::add_options_debug()
 
     add( "NEW_EXPLOSIONS", "debug", translate_marker( "New explosions" ),
          translate_marker( "If true, Rule of Cool explosions will be used." ), false );
+
+    add( "SNAPSHOT_GAS_SPREAD", "debug", translate_marker( "Snapshot gas spread" ),
+         translate_marker( "If true, where gases spread is decided for all tiles at once from the fields as they were at the start of the turn, using several threads.  Faster with big fires and gas clouds, but gases spread a bit differently than otherwise." ),
+         false
+       );
+
+    add( "SOUND_PROPAGATION", "debug", translate_marker( "Sound propagation" ),
+         translate_marker( "If true, the sounds monsters hear travel around walls and get muffled going through them, instead of only getting quieter with distance." ),
+         false
+       );
 }
 
 void options_manager::add_options_world_default()
@@ -2332,6 +2352,11 @@ void options_manager::add_options_world_default()
          true
        );
 
+    add( "BINARY_MAPS", "world_default", translate_marker( "Binary map saves" ),
+         translate_marker( "If true, the map is saved in a binary format that is faster to save and load than JSON.  Existing map files are converted as they get saved again, and can still be loaded after turning this off." ),
+         false
+       );
+
     add_empty_line();
 
     add( "CHARACTER_POINT_POOLS", "world_default", translate_marker( "Character point pools" ),
@@ -3298,6 +3323,7 @@ void options_manager::cache_to_globals()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    monster_fov_bitmaps = ::get_option<bool>( "MONSTER_FOV_BITMAPS" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
 #if defined(SDL_SOUND)
     sounds::sound_enabled = ::get_option<bool>( "SOUND_ENABLED" );
@@ -24,7 +24,15 @@
 #include "type_id.h"
 #include "point.h"
 
-enum astar_state {
+bool pathfinding_settings::same_costs( const pathfinding_settings &rhs ) const
+{
+    return bash_strength == rhs.bash_strength && climb_cost == rhs.climb_cost &&
+           allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+           allow_climb_stairs == rhs.allow_climb_stairs &&
+           avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp;
+}
+
+enum astar_state : uint8_t {
     ASL_NONE,
     ASL_OPEN,
     ASL_CLOSED
@@ -36,82 +44,165 @@ constexpr int flat_index( const tripoint &p )
     return ( p.x * MAPSIZE_Y ) + p.y;
 }
 
+// Tiles that need a closer look than just adding the flat ground cost
+static constexpr pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+// Parents are stored as an offset in a 3x3x3 cube around the tile
+// Anything further away (stairs) is stored in pathfinding_arena::jump_parents
+static constexpr uint8_t PARENT_JUMP = 0xFF;
+
+static uint8_t encode_parent( const tripoint &parent, const tripoint &p )
+{
+    const tripoint d = parent - p;
+    if( std::abs( d.x ) > 1 || std::abs( d.y ) > 1 || std::abs( d.z ) > 1 ) {
+        return PARENT_JUMP;
+    }
+    return static_cast<uint8_t>( ( d.x + 1 ) + ( d.y + 1 ) * 3 + ( d.z + 1 ) * 9 );
+}
+
+static tripoint decode_parent( const uint8_t code, const tripoint &p )
+{
+    return p + tripoint( code % 3 - 1, code / 3 % 3 - 1, code / 9 - 1 );
+}
+
 // Flattened 2D array representing a single z-level worth of pathfinding data
 struct path_data_layer {
+    // Generation of the search in progress, copied from the arena
+    uint16_t current = 0;
+    // Generation of the search that last touched each tile
+    // Tiles not touched by the current search are unvisited, whatever else is stored for them
+    std::array< uint16_t, MAPSIZE_X *MAPSIZE_Y > generation;
     // State is accessed way more often than all other values here
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
-    std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
+    std::array< uint8_t, MAPSIZE_X *MAPSIZE_Y > parent;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
-    std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
-
-    void init( const point &min, const point &max ) {
-        tripoint p;
-        for( p.x = min.x; p.x <= max.x; p.x++ ) {
-            for( p.y = min.y; p.y <= max.y; p.y++ ) {
-                const int ind = flat_index( p );
-                state[ind] = ASL_NONE; // Mark as unvisited
+
+    astar_state get_state( const int index ) const {
+        return generation[index] == current ? state[index] : ASL_NONE;
+    }
+
+    void set_state( const int index, const astar_state s ) {
+        generation[index] = current;
+        state[index] = s;
+    }
+};
+
+pathfinding_arena::pathfinding_arena() = default;
+pathfinding_arena::~pathfinding_arena() = default;
+
+void pathfinding_arena::new_search()
+{
+    open.clear();
+    jump_parents.clear();
+    generation++;
+    if( generation == 0 ) {
+        // Wrapped around, stamps from 65535 searches ago would look current
+        for( auto &layer : layers ) {
+            if( layer != nullptr ) {
+                layer->generation.fill( 0 );
             }
         }
+        generation = 1;
     }
-};
+    for( auto &layer : layers ) {
+        if( layer != nullptr ) {
+            layer->current = generation;
+        }
+    }
+}
+
+path_data_layer &pathfinding_arena::get_layer( const int z )
+{
+    std::unique_ptr< path_data_layer > &ptr = layers[z + OVERMAP_DEPTH];
+    if( ptr == nullptr ) {
+        // Value-initialized, so every tile starts at generation 0, which is never current
+        ptr = std::make_unique<path_data_layer>();
+        ptr->current = generation;
+    }
+    return *ptr;
+}
 
 struct pathfinder {
+    pathfinding_arena &arena;
     point min;
     point max;
-    pathfinder( const point &_min, const point &_max ) :
-        min( _min ), max( _max ) {
+    int minz;
+    int maxz;
+    // Only enter submaps marked in arena.corridor
+    bool use_corridor = false;
+    pathfinder( pathfinding_arena &_arena, const point &_min, const point &_max, int _minz,
+                int _maxz ) :
+        arena( _arena ), min( _min ), max( _max ), minz( _minz ), maxz( _maxz ) {
+        arena.new_search();
     }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
-
-    path_data_layer &get_layer( const int z ) {
-        std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+    bool allowed( const tripoint &p ) const {
+        if( p.x < min.x || p.x > max.x || p.y < min.y || p.y > max.y ||
+            p.z < -OVERMAP_DEPTH || p.z > OVERMAP_HEIGHT ) {
+            return false;
         }
+        return !use_corridor ||
+               arena.corridor[p.z + OVERMAP_DEPTH][p.x / SEEX * MAPSIZE + p.y / SEEY];
+    }
 
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
-        return *ptr;
+    path_data_layer &get_layer( const int z ) {
+        return arena.get_layer( z );
     }
 
     bool empty() const {
-        return open.empty();
+        return arena.open.empty();
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( arena.open.begin(), arena.open.end(), pair_greater_cmp_first() );
+        const tripoint pt = arena.open.back().second;
+        arena.open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
+        if( !allowed( to ) ) {
+            return;
+        }
         auto &layer = get_layer( to.z );
         const int index = flat_index( to );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state to_state = layer.get_state( index );
+        if( ( to_state == ASL_OPEN && gscore >= layer.gscore[index] ) ||
+            to_state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
-        layer.parent[index] = from;
-        layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        layer.parent[index] = encode_parent( from, to );
+        if( layer.parent[index] == PARENT_JUMP ) {
+            arena.jump_parents.emplace_back( to, from );
+        }
+        arena.open.emplace_back( score, to );
+        std::push_heap( arena.open.begin(), arena.open.end(), pair_greater_cmp_first() );
+    }
+
+    tripoint get_parent( const tripoint &p ) {
+        const uint8_t code = get_layer( p.z ).parent[flat_index( p )];
+        if( code != PARENT_JUMP ) {
+            return decode_parent( code, p );
+        }
+        // Latest entry wins, earlier ones were overwritten by better paths
+        for( auto it = arena.jump_parents.rbegin(); it != arena.jump_parents.rend(); ++it ) {
+            if( it->first == p ) {
+                return it->second;
+            }
+        }
+        debugmsg( "Missing parent for route point %d:%d:%d", p.x, p.y, p.z );
+        return p;
     }
 
     void close_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_CLOSED;
+        get_layer( p.z ).set_state( flat_index( p ), ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_NONE;
+        get_layer( p.z ).set_state( flat_index( p ), ASL_NONE );
     }
 };
 
@@ -191,6 +282,319 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// Index of p within the submap that has its corner at origin
+static int local_index( const point &p, const point &origin )
+{
+    return ( p.x - origin.x ) * SEEY + ( p.y - origin.y );
+}
+
+static point submap_origin( const tripoint &p )
+{
+    return point( p.x / SEEX * SEEX, p.y / SEEY * SEEY );
+}
+
+static int submap_index( const tripoint &p )
+{
+    return p.x / SEEX * MAPSIZE + p.y / SEEY;
+}
+
+// Dijkstra over the rough walking costs, without leaving the submap that has its corner at origin
+static void submap_distances( const pathfinding_cache &cache, const point &origin,
+                              const point &from, std::array<int, SEEX * SEEY> &dist )
+{
+    dist.fill( -1 );
+    std::priority_queue< std::pair<int, point>, std::vector< std::pair<int, point> >, pair_greater_cmp_first >
+    open;
+    dist[local_index( from, origin )] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const std::pair<int, point> cur = open.top();
+        open.pop();
+        if( cur.first > dist[local_index( cur.second, origin )] ) {
+            continue;
+        }
+        for( const point &d : eight_adjacent_offsets ) {
+            const point p = cur.second + d;
+            if( p.x < origin.x || p.x >= origin.x + SEEX || p.y < origin.y || p.y >= origin.y + SEEY ) {
+                continue;
+            }
+            const int cost = cache.walk_cost[p.x][p.y];
+            if( cost == 0 ) {
+                continue;
+            }
+            // Same diagonal penalty as the tile search
+            const int g = cur.first + cost + ( d.x != 0 && d.y != 0 ? 1 : 0 );
+            int &best = dist[local_index( p, origin )];
+            if( best < 0 || g < best ) {
+                best = g;
+                open.emplace( g, p );
+            }
+        }
+    }
+}
+
+// Adds a portal in the middle of every open stretch of one border of a submap
+// start is the first tile of the border, step walks along it and across leads out of the submap
+// Tiles that can only be left diagonally get a portal of their own
+static void add_border_portals( const pathfinding_cache &cache, const tripoint &start,
+                                const point &step, const point &across, const int length,
+                                const point &map_size, submap_portals &portals )
+{
+    const auto open = [&cache, &map_size]( const tripoint & p ) {
+        return p.x >= 0 && p.y >= 0 && p.x < map_size.x && p.y < map_size.y &&
+               cache.walk_cost[p.x][p.y] != 0;
+    };
+    int span = 0;
+    for( int i = 0; i <= length; i++ ) {
+        const tripoint p = start + step * i;
+        if( i < length && open( p ) && open( p + across ) ) {
+            span++;
+            continue;
+        }
+        if( span > 0 ) {
+            const tripoint middle = start + step * ( i - 1 - span / 2 );
+            portals.tiles.push_back( middle );
+            portals.exits.push_back( middle + across );
+            span = 0;
+        }
+        if( i == length || !open( p ) ) {
+            continue;
+        }
+        for( const int side : { -1, 1 } ) {
+            // Otherwise the neighbouring border tile leads there
+            const tripoint exit = p + across + step * side;
+            if( open( exit ) && !open( p + step * side ) ) {
+                portals.tiles.push_back( p );
+                portals.exits.push_back( exit );
+            }
+        }
+    }
+}
+
+void map::update_submap_portals( pathfinding_cache &cache, const tripoint &grid ) const
+{
+    submap_portals &portals = cache.portals[grid.x * MAPSIZE + grid.y];
+    portals.tiles.clear();
+    portals.exits.clear();
+    portals.costs.clear();
+
+    const tripoint origin( grid.x * SEEX, grid.y * SEEY, grid.z );
+    const point map_size( SEEX * my_MAPSIZE, SEEY * my_MAPSIZE );
+    if( grid.x > 0 ) {
+        add_border_portals( cache, origin, point_south, point_west, SEEY, map_size, portals );
+    }
+    if( grid.x < my_MAPSIZE - 1 ) {
+        add_border_portals( cache, origin + point( SEEX - 1, 0 ), point_south, point_east, SEEY,
+                            map_size, portals );
+    }
+    if( grid.y > 0 ) {
+        add_border_portals( cache, origin, point_east, point_north, SEEX, map_size, portals );
+    }
+    if( grid.y < my_MAPSIZE - 1 ) {
+        add_border_portals( cache, origin + point( 0, SEEY - 1 ), point_east, point_south, SEEX,
+                            map_size, portals );
+    }
+
+    // Ramps are left to the tile search, they don't need a portal to cross a submap border
+    if( has_zlevels() ) {
+        for( int x = origin.x; x < origin.x + SEEX; x++ ) {
+            for( int y = origin.y; y < origin.y + SEEY; y++ ) {
+                if( !( cache.special[x][y] & PF_UPDOWN ) ) {
+                    continue;
+                }
+                const tripoint p( x, y, grid.z );
+                tripoint below( x, y, grid.z - 1 );
+                if( inbounds_z( below.z ) && has_flag( TFLAG_GOES_DOWN, p ) &&
+                    vertical_move_destination<TFLAG_GOES_UP>( *this, below ) ) {
+                    portals.tiles.push_back( p );
+                    portals.exits.push_back( below );
+                }
+                tripoint above( x, y, grid.z + 1 );
+                if( inbounds_z( above.z ) && has_flag( TFLAG_GOES_UP, p ) &&
+                    vertical_move_destination<TFLAG_GOES_DOWN>( *this, above ) ) {
+                    portals.tiles.push_back( p );
+                    portals.exits.push_back( above );
+                }
+            }
+        }
+    }
+
+    const size_t count = portals.tiles.size();
+    portals.costs.resize( count * count );
+    std::array<int, SEEX * SEEY> dist;
+    for( size_t i = 0; i < count; i++ ) {
+        submap_distances( cache, origin.xy(), portals.tiles[i].xy(), dist );
+        for( size_t j = 0; j < count; j++ ) {
+            portals.costs[i * count + j] = dist[local_index( portals.tiles[j].xy(), origin.xy() )];
+        }
+    }
+}
+
+void map::update_portal_graph( const int zlev ) const
+{
+    if( !inbounds_z( zlev ) ) {
+        return;
+    }
+    // Portals are built from the tile flags and costs
+    get_pathfinding_cache_ref( zlev );
+    pathfinding_cache &cache = get_pathfinding_cache( zlev );
+    if( cache.portals_dirty.none() ) {
+        return;
+    }
+
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( cache.portals_dirty[smx * MAPSIZE + smy] ) {
+                update_submap_portals( cache, tripoint( smx, smy, zlev ) );
+            }
+        }
+    }
+    cache.portals_dirty.reset();
+}
+
+static constexpr int portal_start = -2;
+static constexpr int portal_goal = -1;
+
+static int portal_key( const int z, const int sm, const int index )
+{
+    return ( ( z + OVERMAP_DEPTH ) * MAPSIZE * MAPSIZE + sm ) * 1024 + index;
+}
+
+enum class corridor_result : int {
+    found,
+    // Not even walking, opening doors and climbing everything gets there
+    unreachable,
+    // Gave up on routes that got too long, or that lead up stairs which have changed
+    given_up,
+};
+
+// A* over the portal graph, marking the submaps along the cheapest route in arena.corridor
+// Leaves the corridor untouched if the graph has no route from f to t
+static corridor_result find_corridor( const map &m, pathfinding_arena &arena, const tripoint &f,
+                                      const tripoint &t, const pathfinding_settings &settings,
+                                      int &minz, int &maxz )
+{
+    const auto level = [&m]( const int z ) -> const pathfinding_cache & {
+        m.update_portal_graph( z );
+        return m.get_pathfinding_cache_ref( z );
+    };
+
+    const point f_origin = submap_origin( f );
+    const point t_origin = submap_origin( t );
+    const int f_sm = submap_index( f );
+    const int t_sm = submap_index( t );
+    std::array<int, SEEX * SEEY> from_start;
+    std::array<int, SEEX * SEEY> to_goal;
+    submap_distances( level( f.z ), f_origin, f.xy(), from_start );
+    submap_distances( level( t.z ), t_origin, t.xy(), to_goal );
+
+    // Key -> best cost so far and parent key
+    auto &scores = arena.portal_scores;
+    auto &open = arena.portal_open;
+    scores.clear();
+    open.clear();
+    // Portal routes are a bit longer than the tile routes they stand for
+    bool gave_up = false;
+    const auto relax = [&]( const int key, const int parent, const int g, const tripoint & p ) {
+        if( g > settings.max_length ) {
+            gave_up = true;
+            return;
+        }
+        const auto iter = scores.find( key );
+        if( iter != scores.end() && iter->second.first <= g ) {
+            return;
+        }
+        scores[key] = std::make_pair( g, parent );
+        open.emplace_back( key == portal_goal ? g : g + 2 * rl_dist( p, t ), key );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+    };
+
+    const submap_portals &start_portals = level( f.z ).portals[f_sm];
+    for( size_t i = 0; i < start_portals.tiles.size(); i++ ) {
+        const int dist = from_start[local_index( start_portals.tiles[i].xy(), f_origin )];
+        if( dist >= 0 ) {
+            relax( portal_key( f.z, f_sm, i ), portal_start, dist, start_portals.tiles[i] );
+        }
+    }
+    if( f.z == t.z && f_sm == t_sm && from_start[local_index( t.xy(), f_origin )] >= 0 ) {
+        relax( portal_goal, portal_start, from_start[local_index( t.xy(), f_origin )], t );
+    }
+
+    bool found = false;
+    while( !open.empty() ) {
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const std::pair<int, int> cur = open.back();
+        open.pop_back();
+        const int key = cur.second;
+        if( key == portal_goal ) {
+            found = true;
+            break;
+        }
+
+        const int g = scores[key].first;
+        const int index = key % 1024;
+        const int sm = key / 1024 % ( MAPSIZE * MAPSIZE );
+        const int z = key / 1024 / ( MAPSIZE * MAPSIZE ) - OVERMAP_DEPTH;
+        const submap_portals &portals = level( z ).portals[sm];
+        const tripoint p = portals.tiles[index];
+        if( cur.first > g + 2 * rl_dist( p, t ) ) {
+            // Reached again with a lower cost since this entry was queued
+            continue;
+        }
+
+        if( z == t.z && sm == t_sm ) {
+            const int dist = to_goal[local_index( p.xy(), t_origin )];
+            if( dist >= 0 ) {
+                relax( portal_goal, key, g + dist, t );
+            }
+        }
+
+        const size_t count = portals.tiles.size();
+        for( size_t i = 0; i < count; i++ ) {
+            const int cost = portals.costs[index * count + i];
+            if( static_cast<int>( i ) != index && cost >= 0 ) {
+                relax( portal_key( z, sm, i ), key, g + cost, portals.tiles[i] );
+            }
+        }
+
+        const tripoint exit = portals.exits[index];
+        if( exit.z != z && !settings.allow_climb_stairs ) {
+            continue;
+        }
+        const int exit_sm = submap_index( exit );
+        const pathfinding_cache &exit_level = level( exit.z );
+        const submap_portals &next = exit_level.portals[exit_sm];
+        const auto next_iter = std::find( next.tiles.begin(), next.tiles.end(), exit );
+        if( next_iter == next.tiles.end() ) {
+            // Stairs whose other end has changed since this level was last updated
+            gave_up = true;
+            continue;
+        }
+        const int step = exit.z == z ? exit_level.walk_cost[exit.x][exit.y] : 2;
+        relax( portal_key( exit.z, exit_sm, next_iter - next.tiles.begin() ), key, g + step, exit );
+    }
+
+    if( !found ) {
+        return gave_up ? corridor_result::given_up : corridor_result::unreachable;
+    }
+
+    for( auto &layer : arena.corridor ) {
+        layer.reset();
+    }
+    minz = std::min( f.z, t.z );
+    maxz = std::max( f.z, t.z );
+    arena.corridor[f.z + OVERMAP_DEPTH].set( f_sm );
+    arena.corridor[t.z + OVERMAP_DEPTH].set( t_sm );
+    for( int key = scores[portal_goal].second; key != portal_start; key = scores[key].second ) {
+        const int sm = key / 1024 % ( MAPSIZE * MAPSIZE );
+        const int z = key / 1024 / ( MAPSIZE * MAPSIZE ) - OVERMAP_DEPTH;
+        arena.corridor[z + OVERMAP_DEPTH].set( sm );
+        minz = std::min( minz, z );
+        maxz = std::max( maxz, z );
+    }
+    return corridor_result::found;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -210,21 +614,9 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return route( f, clipped, settings, pre_closed );
     }
     // First, check for a simple straight line on flat ground
-    // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
-    if( f.z == t.z ) {
-        const auto line_path = line_to( f, t );
-        const auto &pf_cache = get_pathfinding_cache_ref( f.z );
-        // Check all points for any special case (including just hard terrain)
-        if( std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
-        return !( pf_cache.special[p.x][p.y] & non_normal );
-        } ) ) {
-            const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
-
-            if( is_disjoint( sorted_line, pre_closed ) ) {
-                return line_path;
-            }
-        }
+    ret = straight_route( f, t, pre_closed );
+    if( !ret.empty() ) {
+        return ret;
     }
 
     // If expected path length is greater than max distance, allow only line path, like above
@@ -232,31 +624,80 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
-    int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
+    if( pathfinding_state == nullptr ) {
+        pathfinding_state = std::make_unique<pathfinding_arena>();
+    }
+    pathfinding_arena &arena = *pathfinding_state;
+
+    // Plan the route submap by submap, then refine it tile by tile inside the submaps it crosses
+    int minz = 0;
+    int maxz = 0;
+    const corridor_result corridor = find_corridor( *this, arena, f, t, settings, minz, maxz );
+    if( corridor == corridor_result::found ) {
+        pathfinder pf( arena, point_zero, point( SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1 ),
+                       minz, maxz );
+        pf.use_corridor = true;
+        ret = route_search( pf, f, t, settings, pre_closed );
+        if( !ret.empty() ) {
+            return ret;
+        }
+    }
 
-    const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
+    // The portal graph only knows plain walking, opening doors and climbing.
+    // Routes that need bashing or get blocked by creature specific limits are searched
+    // for in a box around the endpoints instead.
+    // Without bashing, a search within one z-level can't get anywhere the graph can't, so
+    // there is no point in it.
+    if( corridor == corridor_result::unreachable && settings.bash_strength <= 0 && f.z == t.z ) {
+        return ret;
+    }
+    const int pad = 16;
     int minx = std::min( f.x, t.x ) - pad;
     int miny = std::min( f.y, t.y ) - pad;
-    // TODO: Make this way bigger
-    int minz = std::min( f.z, t.z );
+    minz = std::min( f.z, t.z );
     int maxx = std::max( f.x, t.x ) + pad;
     int maxy = std::max( f.y, t.y ) + pad;
-    // Same TODO: as above
-    int maxz = std::max( f.z, t.z );
+    maxz = std::max( f.z, t.z );
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( point( minx, miny ), point( maxx, maxy ) );
+    pathfinder pf( arena, point( minx, miny ), point( maxx, maxy ), minz, maxz );
+    return route_search( pf, f, t, settings, pre_closed );
+}
+
+std::vector<tripoint> map::straight_route( const tripoint &f, const tripoint &t,
+        const std::set<tripoint> &pre_closed ) const
+{
+    if( f.z != t.z ) {
+        return std::vector<tripoint>();
+    }
+    const auto line_path = line_to( f, t );
+    const auto &pf_cache = get_pathfinding_cache_ref( f.z );
+    // Check all points for any special case (including just hard terrain)
+    if( !std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+    return !( pf_cache.special[p.x][p.y] & non_normal );
+    } ) ) {
+        return std::vector<tripoint>();
+    }
+    // Except when the line contains a pre-closed tile - we need to do regular pathing then
+    const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
+    if( !is_disjoint( sorted_line, pre_closed ) ) {
+        return std::vector<tripoint>();
+    }
+    return line_path;
+}
+
+std::vector<tripoint> map::route_search( pathfinder &pf, const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed ) const
+{
+    std::vector<tripoint> ret;
+    const int max_length = settings.max_length;
+
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
-        if( p.x >= minx && p.x < maxx && p.y >= miny && p.y < maxy ) {
+        if( pf.allowed( p ) ) {
             pf.close_point( p );
         }
     }
@@ -273,12 +714,12 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
-        if( layer.gscore[parent_index] > max_length ) {
+        const int cur_g = layer.gscore[parent_index];
+        if( cur_g > max_length ) {
             // Shortest path would be too long, return empty vector
             return std::vector<tripoint>();
         }
@@ -288,7 +729,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
@@ -306,156 +747,34 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             const int index = flat_index( p );
 
             // TODO: Remove this and instead have sentinels at the edges
-            if( p.x < minx || p.x >= maxx || p.y < miny || p.y >= maxy ) {
+            if( !pf.allowed( p ) ) {
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.get_state( index ) == ASL_CLOSED ) {
                 continue;
             }
 
-            // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
-                }
-
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                if( cur_veh &&
-                    !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
-                    //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
-                    continue;
-                }
-
-                if( veh && veh != cur_veh &&
-                    !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
-                    //Same as above but moving into rather than out of a vehicle
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->cpart( part ).hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
-
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
-                }
-
+            const route_step step = get_route_step( cur, cur_veh, p, pf_cache, settings );
+            if( step.close ) {
+                // Close it so that next time we won't try to calculate costs
+                layer.set_state( index, ASL_CLOSED );
+            }
+            if( step.drop ) {
+                // From cur, not p, because we won't be walking on air
+                const tripoint below( p.xy(), p.z - 1 );
+                pf.add_point( cur_g + 10, cur_g + 10 + 2 * rl_dist( below, t ), cur, below );
+            }
+            if( step.blocked ) {
+                continue;
             }
 
+            // Penalize for diagonals or the path will look "unnatural"
+            const int newg = cur_g + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 ) + step.cost;
+
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.get_state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -467,52 +786,37 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const maptile &parent_tile = maptile_at_internal( cur );
         const auto &parent_terrain = parent_tile.get_ter_t();
-        if( settings.allow_climb_stairs && cur.z > minz && parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
+        if( settings.allow_climb_stairs && cur.z > pf.minz && parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
-                              cur, dest );
+                pf.add_point( cur_g + 2, cur_g + 2 + 2 * rl_dist( dest, t ), cur, dest );
             }
         }
-        if( settings.allow_climb_stairs && cur.z < maxz && parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
+        if( settings.allow_climb_stairs && cur.z < pf.maxz && parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
-                              cur, dest );
+                pf.add_point( cur_g + 2, cur_g + 2 + 2 * rl_dist( dest, t ), cur, dest );
             }
         }
-        if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
+        if( cur.z < pf.maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
             valid_move( cur, tripoint( cur.xy(), cur.z + 1 ), false, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
-                              cur, above );
+                pf.add_point( cur_g + 4, cur_g + 4 + 2 * rl_dist( above, t ), cur, above );
             }
         }
-        if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP_UP ) &&
+        if( cur.z < pf.maxz && parent_terrain.has_flag( TFLAG_RAMP_UP ) &&
             valid_move( cur, tripoint( cur.xy(), cur.z + 1 ), false, true, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
-                              cur, above );
+                pf.add_point( cur_g + 4, cur_g + 4 + 2 * rl_dist( above, t ), cur, above );
             }
         }
-        if( cur.z > minz && parent_terrain.has_flag( TFLAG_RAMP_DOWN ) &&
+        if( cur.z > pf.minz && parent_terrain.has_flag( TFLAG_RAMP_DOWN ) &&
             valid_move( cur, tripoint( cur.xy(), cur.z - 1 ), false, true, true ) ) {
-            auto &layer = pf.get_layer( cur.z - 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint below( cur.x + x_offset[it], cur.y + y_offset[it], cur.z - 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( below, t ),
-                              cur, below );
+                pf.add_point( cur_g + 4, cur_g + 4 + 2 * rl_dist( below, t ), cur, below );
             }
         }
 
@@ -523,12 +827,10 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         tripoint cur = t;
         // Just to limit max distance, in case something weird happens
         for( int fdist = max_length; fdist != 0; fdist-- ) {
-            const int cur_index = flat_index( cur );
-            const auto &layer = pf.get_layer( cur.z );
-            const tripoint &par = layer.parent[cur_index];
             if( cur == f ) {
                 break;
             }
+            const tripoint par = pf.get_parent( cur );
 
             ret.push_back( cur );
             // Jumps are acceptable on 1 z-level changes
@@ -547,3 +849,269 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
     return ret;
 }
+
+route_step map::get_route_step( const tripoint &cur, const vehicle *cur_veh, const tripoint &p,
+                                const pathfinding_cache &pf_cache,
+                                const pathfinding_settings &settings ) const
+{
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+
+    route_step ret;
+    const auto blocked = [&ret]( const bool close ) {
+        ret.blocked = true;
+        ret.close = close;
+        return ret;
+    };
+
+    const auto p_special = pf_cache.special[p.x][p.y];
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        ret.cost = 2;
+        return ret;
+    }
+
+    if( settings.avoid_rough_terrain ) {
+        // Close all rough terrain tiles
+        return blocked( true );
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        return blocked( true );
+    }
+
+    if( cur_veh &&
+        !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
+        //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
+        return blocked( false );
+    }
+
+    if( veh && veh != cur_veh &&
+        !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
+        //Same as above but moving into rather than out of a vehicle
+        return blocked( false );
+    }
+
+    ret.cost = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            ret.cost += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                     !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            ret.cost += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) || cur_veh == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                ret.cost += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->cpart( part ).hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    return blocked( true );
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                ret.cost += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                // Won't be openable, don't try from other sides
+                return blocked( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) );
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            ret.cost += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            ret.cost += 500;
+        } else {
+            // Unbashable and unopenable from here
+            // Or anywhere else for that matter
+            return blocked( !doors || !terrain.open || !furniture.open );
+        }
+    }
+
+    if( settings.avoid_traps && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    // Otherwise this would have been a huge fall
+                    ret.drop = !has_flag( TFLAG_NO_FLOOR, tripoint( p.xy(), p.z - 1 ) );
+                    // Close p, because we won't be walking on it
+                    return blocked( true );
+                }
+            } else {
+                // Otherwise it's walkable
+                ret.cost += 500;
+            }
+        }
+    }
+
+    if( settings.avoid_sharp && p_special & PF_SHARP ) {
+        // Avoid sharp things
+        return blocked( true );
+    }
+
+    return ret;
+}
+
+const flow_field *map::get_flow_field( const tripoint &t, const pathfinding_settings &settings,
+                                       const Creature *requester ) const
+{
+    if( pathfinding_state == nullptr ) {
+        pathfinding_state = std::make_unique<pathfinding_arena>();
+    }
+    pathfinding_arena &arena = *pathfinding_state;
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+
+    flow_field *field = nullptr;
+    for( const std::unique_ptr<flow_field> &candidate : arena.flow_fields ) {
+        if( candidate->target == t && candidate->settings.same_costs( settings ) ) {
+            field = candidate.get();
+            break;
+        }
+    }
+    if( field == nullptr ) {
+        // A single creature is better off with a directed search
+        static constexpr size_t max_flow_fields = 8;
+        if( arena.flow_fields.size() < max_flow_fields ) {
+            arena.flow_fields.emplace_back( std::make_unique<flow_field>() );
+            field = arena.flow_fields.back().get();
+        } else {
+            field = std::min_element( arena.flow_fields.begin(), arena.flow_fields.end(),
+            []( const std::unique_ptr<flow_field> &a, const std::unique_ptr<flow_field> &b ) {
+                return a->last_used < b->last_used;
+            } )->get();
+        }
+        field->target = t;
+        field->settings = settings;
+        field->version = pf_cache.version;
+        field->built = false;
+        field->requester = requester;
+        field->last_used = ++arena.flow_field_uses;
+        return nullptr;
+    }
+    field->last_used = ++arena.flow_field_uses;
+
+    if( field->version != pf_cache.version ) {
+        // The map changed, so wait for a second requester again before rebuilding
+        field->version = pf_cache.version;
+        field->built = false;
+        field->requester = requester;
+        return nullptr;
+    }
+    if( !field->built && field->requester == requester ) {
+        // The same creature asking again, e.g. on its next turn
+        return nullptr;
+    }
+    if( field->built && field->limit >= settings.max_length ) {
+        return field;
+    }
+
+    // Dijkstra outwards from the target, costing each step in the direction it will be walked
+    field->settings = settings;
+    field->limit = settings.max_length;
+    field->built = true;
+    field->dist.fill( -1 );
+    field->dist[flat_index( t )] = 0;
+    auto &open = arena.open;
+    open.clear();
+    open.emplace_back( 0, t );
+    while( !open.empty() ) {
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const std::pair<int, tripoint> cur = open.back();
+        open.pop_back();
+        if( cur.first > field->dist[flat_index( cur.second )] ) {
+            continue;
+        }
+        for( size_t i = 0; i < eight_adjacent_offsets.size(); i++ ) {
+            const tripoint from = cur.second - eight_adjacent_offsets[i];
+            if( !inbounds( from ) ) {
+                continue;
+            }
+            int part;
+            const vehicle *from_veh = veh_at_internal( from, part );
+            const route_step step = get_route_step( from, from_veh, cur.second, pf_cache, settings );
+            if( step.close ) {
+                // Nothing can walk onto cur, so don't bother with its other neighbors
+                break;
+            }
+            if( step.blocked ) {
+                // Including ledges, drops leave the z-level
+                continue;
+            }
+            const int g = cur.first + step.cost + ( ( from.x != cur.second.x &&
+                                                      from.y != cur.second.y ) ? 1 : 0 );
+            int &best = field->dist[flat_index( from )];
+            if( g <= field->limit && ( best < 0 || g < best ) ) {
+                best = g;
+                field->next[flat_index( from )] = static_cast<uint8_t>( i );
+                open.emplace_back( g, from );
+                std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+            }
+        }
+    }
+    return field;
+}
+
+std::vector<tripoint> map::route_shared( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const Creature *requester ) const
+{
+    if( f == t || f.z != t.z || !inbounds( f ) || !inbounds( t ) ) {
+        return route( f, t, settings );
+    }
+
+    std::vector<tripoint> ret = straight_route( f, t, {} );
+    if( !ret.empty() ) {
+        return ret;
+    }
+    // If expected path length is greater than max distance, allow only line path, like above
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return ret;
+    }
+
+    const flow_field *field = get_flow_field( t, settings, requester );
+    if( field == nullptr || field->dist[flat_index( f )] < 0 ) {
+        // Not shared yet, or the route needs another z-level
+        return route( f, t, settings );
+    }
+    if( field->dist[flat_index( f )] > settings.max_length ) {
+        return ret;
+    }
+
+    tripoint cur = f;
+    while( cur != t ) {
+        cur += eight_adjacent_offsets[field->next[flat_index( cur )]];
+        ret.push_back( cur );
+    }
+    return ret;
+}
@@ -2,7 +2,18 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
+
+class Creature;
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -38,13 +49,37 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
+/**
+ * Entrances of a single submap for the coarse, submap level route search.
+ * A portal is a tile where a route can leave the submap: the middle of each open stretch
+ * of its border, or a staircase. See @ref map::update_portal_graph.
+ */
+struct submap_portals {
+    /** Portal tiles in this submap, in local map coordinates. */
+    std::vector<tripoint> tiles;
+    /** Where stepping out of each portal leads: across the border, or the other end of the stairs. */
+    std::vector<tripoint> exits;
+    /** Cost of walking from tiles[i] to tiles[j] without leaving the submap, at i * tiles.size() + j. -1 if there is no such path. */
+    std::vector<int> costs;
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
     ~pathfinding_cache();
 
     bool dirty;
+    // Incremented on every change to the level, to tell when anything derived from it is stale
+    int version = 0;
+    // Submaps whose tiles in special need recalculating, indexed like level_cache::transparency_cache_dirty
+    std::bitset<MAPSIZE *MAPSIZE> dirty_submaps;
+    // Submaps whose portals need recalculating
+    std::bitset<MAPSIZE *MAPSIZE> portals_dirty;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+    // Rough cost of stepping onto each tile, ignoring creature specific abilities. 0 if it blocks.
+    uint8_t walk_cost[MAPSIZE_X][MAPSIZE_Y];
+
+    std::array<submap_portals, MAPSIZE *MAPSIZE> portals;
 };
 
 struct pathfinding_settings {
@@ -71,6 +106,75 @@ struct pathfinding_settings {
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
     pathfinding_settings &operator = ( const pathfinding_settings & ) = default;
+
+    /** Whether routes cost the same under both settings. Distance limits aren't compared. */
+    bool same_costs( const pathfinding_settings &rhs ) const;
+};
+
+/** Outcome of stepping from one tile onto its neighbor during a route search. */
+struct route_step {
+    /** Cost of the step, without the diagonal penalty. */
+    int cost = 0;
+    /** The step can't be taken from this tile. */
+    bool blocked = false;
+    /** The destination can't be entered from anywhere. */
+    bool close = false;
+    /** The destination is a ledge that can be safely dropped from, to the tile below it. */
+    bool drop = false;
+};
+
+/**
+ * Cost of reaching one target from every tile around it on the same z-level, shared by all
+ * creatures with equivalent pathfinding settings. See @ref map::route_shared.
+ */
+struct flow_field {
+    tripoint target;
+    pathfinding_settings settings;
+    /** Version of the target's pathfinding cache level the field was built from. */
+    int version = 0;
+    /** Tiles further than this from the target weren't explored. */
+    int limit = 0;
+    /** Fields are only built once a second creature asks for the same target. */
+    bool built = false;
+    /** First creature to ask for the target since the field's version changed. */
+    const Creature *requester = nullptr;
+    int last_used = 0;
+    /** Cost of reaching the target from each tile, -1 if it can't be reached. */
+    std::array< int, MAPSIZE_X *MAPSIZE_Y > dist;
+    /** Step towards the target from each tile, as an index into eight_adjacent_offsets. */
+    std::array< uint8_t, MAPSIZE_X *MAPSIZE_Y > next;
+};
+
+struct path_data_layer;
+
+/**
+ * Search state reused by every @ref map::route call on a given map.
+ * Layers are allocated on first use and never freed. Each tile is stamped with
+ * the generation of the search that last touched it, so starting a new search
+ * only bumps @ref generation instead of reallocating and clearing whole layers.
+ */
+struct pathfinding_arena {
+    pathfinding_arena();
+    ~pathfinding_arena();
+
+    /** Invalidates all per-tile data left by the previous search. */
+    void new_search();
+    path_data_layer &get_layer( int z );
+
+    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > layers;
+    /** Open list, kept as a binary heap. Keeps its capacity between searches. */
+    std::vector< std::pair<int, tripoint> > open;
+    /** Parents of tiles reached by a jump (stairs), which don't fit in a direction byte. */
+    std::vector< std::pair<tripoint, tripoint> > jump_parents;
+    /** Submaps the current tile search may enter, if restricted to a corridor. */
+    std::array< std::bitset<MAPSIZE *MAPSIZE>, OVERMAP_LAYERS > corridor;
+    /** Coarse search state: best cost and parent for each portal reached. */
+    std::unordered_map< int, std::pair<int, int> > portal_scores;
+    std::vector< std::pair<int, int> > portal_open;
+    /** Most recently used distance fields, see @ref map::route_shared. */
+    std::vector< std::unique_ptr< flow_field > > flow_fields;
+    int flow_field_uses = 0;
+    uint16_t generation = 0;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
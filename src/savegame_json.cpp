@@ -3198,7 +3198,8 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout, std::vector<std::string> &names,
+                           std::map<std::uint32_t, int> &names_index ) const
 {
     jsout.start_array();
 
@@ -3208,8 +3209,12 @@ void mm_submap::serialize( JsonOut &jsout ) const
     int num_same = 1;
 
     const auto write_seq = [&]() {
+        const auto inserted = names_index.emplace( last.tile.tile_id, names.size() );
+        if( inserted.second ) {
+            names.push_back( last.tile.tile() );
+        }
         jsout.start_array();
-        jsout.write( last.tile.tile );
+        jsout.write( inserted.first->second );
         jsout.write( last.tile.subtile );
         jsout.write( last.tile.rotation );
         jsout.write( last.symbol );
@@ -3241,7 +3246,12 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( JsonIn &jsin )
+/**
+ * Reads the runs of memorized tiles of a submap, @p read_tile reads the tile name,
+ * subtile and rotation at the start of a run.
+ */
+template<typename ReadTile>
+static void deserialize_mm_runs( mm_submap &sm, JsonIn &jsin, ReadTile read_tile )
 {
     jsin.start_array();
 
@@ -3256,9 +3266,7 @@ void mm_submap::deserialize( JsonIn &jsin )
                 remaining -= 1;
             } else {
                 jsin.start_array();
-                elem.tile.tile = jsin.get_string();
-                elem.tile.subtile = jsin.get_int();
-                elem.tile.rotation = jsin.get_int();
+                elem.tile = read_tile();
                 elem.symbol = jsin.get_int();
                 if( jsin.test_int() ) {
                     remaining = jsin.get_int() - 1;
@@ -3268,18 +3276,49 @@ void mm_submap::deserialize( JsonIn &jsin )
             point p( x, y );
             // Try to avoid assigning to save up on memory
             if( elem.tile != mm_submap::default_tile ) {
-                set_tile( p, elem.tile );
+                sm.set_tile( p, elem.tile );
             }
             if( elem.symbol != mm_submap::default_symbol ) {
-                set_symbol( p, elem.symbol );
+                sm.set_symbol( p, elem.symbol );
             }
         }
     }
     jsin.end_array();
 }
 
+void mm_submap::deserialize( JsonIn &jsin, const std::vector<std::uint32_t> &tile_ids )
+{
+    deserialize_mm_runs( *this, jsin, [&]() {
+        const int index = jsin.get_int();
+        if( index < 0 || static_cast<size_t>( index ) >= tile_ids.size() ) {
+            jsin.error( "invalid memorized tile index" );
+        }
+        memorized_terrain_tile tile;
+        tile.tile_id = tile_ids[index];
+        tile.subtile = jsin.get_int();
+        tile.rotation = jsin.get_int();
+        return tile;
+    } );
+}
+
+void mm_submap::deserialize_legacy( JsonIn &jsin )
+{
+    deserialize_mm_runs( *this, jsin, [&]() {
+        const std::string name = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        return memorized_terrain_tile( name, subtile, rotation );
+    } );
+}
+
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Tile names are only written once per region, the submaps refer to them by index.
+    std::vector<std::string> names;
+    std::map<std::uint32_t, int> names_index;
+
+    jsout.start_object();
+    jsout.member( "submaps" );
     jsout.start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -3289,30 +3328,47 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, names, names_index );
             }
         }
     }
     jsout.end_array();
+    jsout.member( "tiles", names );
+    jsout.end_object();
 }
 
 void mm_region::deserialize( JsonIn &jsin )
 {
-    jsin.start_array();
+    // Regions used to be plain arrays of submaps, with the tile names written out in full.
+    const bool legacy = jsin.test_array();
+    std::vector<std::uint32_t> tile_ids;
+    cata::optional<JsonObject> jo;
+    JsonIn *submaps_in = &jsin;
+    if( !legacy ) {
+        jo.emplace( jsin.get_object() );
+        for( const std::string &name : jo->get_string_array( "tiles" ) ) {
+            tile_ids.push_back( memorized_terrain_tile( name, 0, 0 ).tile_id );
+        }
+        submaps_in = jo->get_raw( "submaps" );
+    }
+
+    submaps_in->start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
             shared_ptr_fast<mm_submap> &sm = submaps[x][y];
             sm = make_shared_fast<mm_submap>();
-            if( jsin.test_null() ) {
-                jsin.skip_null();
+            if( submaps_in->test_null() ) {
+                submaps_in->skip_null();
+            } else if( legacy ) {
+                sm->deserialize_legacy( *submaps_in );
             } else {
-                sm->deserialize( jsin );
+                sm->deserialize( *submaps_in, tile_ids );
             }
         }
     }
-    jsin.end_array();
+    submaps_in->end_array();
 }
 
 void map_memory::load_legacy( JsonIn &jsin )
@@ -3332,9 +3388,10 @@ void map_memory::load_legacy( JsonIn &jsin )
         p.y = jsin.get_int();
         p.z = jsin.get_int();
         mig_elem &elem = elems[p];
-        elem.tile.tile = jsin.get_string();
-        elem.tile.subtile = jsin.get_int();
-        elem.tile.rotation = jsin.get_int();
+        const std::string name = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        elem.tile = memorized_terrain_tile( name, subtile, rotation );
         jsin.end_array();
     }
     jsin.start_array();
@@ -3719,11 +3776,8 @@ void stats_tracker::deserialize( JsonIn &jsin )
     jo.read( "initial_scores", initial_scores );
 }
 
-void submap::store( JsonOut &jsout ) const
+void submap::store_tile_layers( JsonOut &jsout ) const
 {
-    jsout.member( "turn_last_touched", last_touched );
-    jsout.member( "temperature", temperature );
-
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
     // this feature but the algorithm is backward compatible.
     jsout.member( "terrain" );
@@ -3809,20 +3863,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3861,6 +3901,30 @@ void submap::store( JsonOut &jsout ) const
         }
     }
     jsout.end_array();
+}
+
+void submap::store( JsonOut &jsout, const bool with_tile_layers ) const
+{
+    jsout.member( "turn_last_touched", last_touched );
+    jsout.member( "temperature", temperature );
+
+    if( with_tile_layers ) {
+        store_tile_layers( jsout );
+    }
+
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( itm[i][j] );
+        }
+    }
+    jsout.end_array();
 
     // Write out as array of arrays of single entries
     jsout.member( "cosmetics" );
@@ -3990,7 +4054,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             int rad_num = jsin.get_int();
             for( int i = 0; i < rad_num; ++i ) {
                 if( rad_cell < SEEX * SEEY ) {
-                    set_radiation( { 0 % SEEX, rad_cell / SEEX }, rad_strength );
+                    set_radiation( { rad_cell % SEEX, rad_cell / SEEX }, rad_strength );
                     rad_cell++;
                 }
             }
@@ -4073,6 +4137,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                     field_count++;
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                mark_field_active( { i, j } );
             }
         }
     } else if( member_name == "graffiti" ) {
@@ -136,6 +136,10 @@ void scenario::check_definitions()
     for( const auto &scen : all_scenarios.get_all() ) {
         scen.check_definition();
     }
+}
+
+void scenario::finalize_all()
+{
     sc_blacklist.finalize();
 }
 
@@ -67,6 +67,8 @@ class scenario
         static void reset();
         /** calls @ref check_definition for each scenario */
         static void check_definitions();
+        /** Resolves the scenario blacklist, once all scenarios are loaded. */
+        static void finalize_all();
         /** Check that item definitions are valid */
         void check_definition() const;
 
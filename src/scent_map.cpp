@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <iterator>
 
 #include "assign.h"
 #include "calendar.h"
@@ -158,88 +159,129 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    //the block and reduce scent properties are folded into a single scent_transfer value here
-    //block=0 reduce=1 normal=5
-    scent_array<char> scent_transfer;
-
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
-
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
-                center.z ).vehicle_obstructed_cache;
-
     // for loop constants
     const int scentmap_minx = center.x - SCENT_RADIUS;
     const int scentmap_maxx = center.x + SCENT_RADIUS;
     const int scentmap_miny = center.y - SCENT_RADIUS;
     const int scentmap_maxy = center.y + SCENT_RADIUS;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    // Scent only moves one tile per update, so any tile further than that from existing scent
+    // would be recomputed as 0, which is what it is already. Only update around the scent.
+    point scent_min( scentmap_maxx + 2, scentmap_maxy + 2 );
+    point scent_max( scentmap_minx - 2, scentmap_miny - 2 );
+    const auto is_scented = []( int scent ) {
+        return scent != 0;
+    };
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const auto first = grscent[x].begin() + scentmap_miny - 1;
+        const auto last = grscent[x].begin() + scentmap_maxy + 2;
+        const auto lowest = std::find_if( first, last, is_scented );
+        if( lowest == last ) {
+            continue;
+        }
+        const auto highest = std::find_if( std::make_reverse_iterator( last ),
+                                           std::make_reverse_iterator( lowest ), is_scented );
+        scent_min.x = std::min( scent_min.x, x );
+        scent_max.x = x;
+        scent_min.y = std::min<int>( scent_min.y, lowest - grscent[x].begin() );
+        scent_max.y = std::max<int>( scent_max.y, highest.base() - 1 - grscent[x].begin() );
+    }
+    const int minx = std::max( scent_min.x - 1, scentmap_minx );
+    const int maxx = std::min( scent_max.x + 1, scentmap_maxx );
+    const int miny = std::max( scent_min.y - 1, scentmap_miny );
+    const int maxy = std::min( scent_max.y + 1, scentmap_maxy );
+    if( minx > maxx || miny > maxy ) {
+        return;
     }
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+    //the block and reduce scent properties are folded into a single scent_transfer value here
+    //block=0 reduce=1 normal=5
+    scent_array<char> scent_transfer;
+    m.scent_blockers( scent_transfer, point( minx - 1, miny - 1 ), point( maxx + 1, maxy + 1 ) );
 
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
 
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+    // Column major like grscent, so that the inner loops run over contiguous memory.
+    // Column 0 is x == minx - 1, row 0 is y == miny.
+    static constexpr int max_width = SCENT_RADIUS * 2 + 3;
+    static constexpr int max_height = SCENT_RADIUS * 2 + 1;
+    std::array<std::array<int, max_height>, max_width> new_scent;
+    std::array<std::array<int, max_height>, max_width> sum_3_scent_y;
+    std::array<std::array<int, max_height>, max_width> squares_used_y;
+    const int width = maxx - minx + 3;
+    const int height = maxy - miny + 1;
+
+    // Sum of the 3 vertically neighboring squares that can diffuse into each square,
+    // weighted by how much they let through.
+    for( int i = 0; i < width; ++i ) {
+        const int x = minx - 1 + i;
+        const char *transfer = scent_transfer[x].data() + miny;
+        const int *scent = grscent[x].data() + miny;
+        int *sum = sum_3_scent_y[i].data();
+        int *used = squares_used_y[i].data();
+        for( int j = 0; j < height; ++j ) {
+            sum[j] = transfer[j - 1] * scent[j - 1] + transfer[j] * scent[j] +
+                     transfer[j + 1] * scent[j + 1];
+            used[j] = transfer[j - 1] + transfer[j] + transfer[j + 1];
         }
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+    // Vehicle holes are rare, most columns won't need them handled at all.
+    std::array<bool, max_width> has_holes;
+    for( int i = 0; i < width; ++i ) {
+        const diagonal_blocks *blocks = blocked_cache[minx - 1 + i] + miny - 1;
+        bool any = false;
+        for( int j = 0; j <= height; ++j ) {
+            any |= blocks[j].nw | blocks[j].ne;
+        }
+        has_holes[i] = any;
+    }
 
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+    std::array<int, max_height> squares_used;
+    std::array<int, max_height> total;
+    for( int i = 1; i < width - 1; ++i ) {
+        const int x = minx - 1 + i;
+        for( int j = 0; j < height; ++j ) {
+            squares_used[j] = squares_used_y[i - 1][j] + squares_used_y[i][j] + squares_used_y[i + 1][j];
+            total[j] = sum_3_scent_y[i - 1][j] + sum_3_scent_y[i][j] + sum_3_scent_y[i + 1][j];
+        }
 
-            //handle vehicle holes
-            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+        //handle vehicle holes
+        const bool near_holes = has_holes[i - 1] || has_holes[i] || has_holes[i + 1];
+        for( int j = 0; near_holes && j < height; ++j ) {
+            const int y = miny + j;
+            if( blocked_cache[x][y].nw && scent_transfer[x + 1][y + 1] == 5 ) {
+                squares_used[j] -= 4;
+                total[j] -= 4 * grscent[x + 1][y + 1];
             }
-            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            if( blocked_cache[x][y].ne && scent_transfer[x - 1][y + 1] == 5 ) {
+                squares_used[j] -= 4;
+                total[j] -= 4 * grscent[x - 1][y + 1];
             }
-            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            if( blocked_cache[x - 1][y - 1].nw && scent_transfer[x - 1][y - 1] == 5 ) {
+                squares_used[j] -= 4;
+                total[j] -= 4 * grscent[x - 1][y - 1];
             }
-            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            if( blocked_cache[x + 1][y - 1].ne && scent_transfer[x + 1][y - 1] == 5 ) {
+                squares_used[j] -= 4;
+                total[j] -= 4 * grscent[x + 1][y - 1];
             }
+        }
 
+        const char *transfer = scent_transfer[x].data() + miny;
+        const int *scent = grscent[x].data() + miny;
+        int *result = new_scent[i].data();
+        for( int j = 0; j < height; ++j ) {
             //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+            int temp_scent = scent[j] * ( 250 - squares_used[j] * transfer[j] );
+            temp_scent -= scent[j] * transfer[j] * ( 45 - squares_used[j] ) / 5;
 
+            result[j] = ( temp_scent + total[j] * transfer[j] ) / 250;
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+    for( int i = 1; i < width - 1; ++i ) {
+        std::copy_n( new_scent[i].begin(), height, grscent[minx - 1 + i].begin() + miny );
     }
 }
 
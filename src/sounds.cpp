@@ -1,22 +1,29 @@
 #include "sounds.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <ostream>
+#include <queue>
 #include <set>
 #include <system_error>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "avatar.h"
 #include "bodypart.h"
 #include "cached_options.h"
 #include "calendar.h"
+#include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
@@ -32,6 +39,7 @@
 #include "monster.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "overmapbuffer.h"
 #include "player.h"
 #include "player_activity.h"
@@ -301,10 +309,132 @@ static int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
+namespace
+{
+
+/**
+ * Floods the distance sounds travel over a z-level, going around obstacles or through them
+ * at the cost of @ref wall_attenuation extra tiles each.
+ */
+class sound_propagation
+{
+    public:
+        /** Extra distance a sound loses going through one wall or other obstacle. */
+        static constexpr int wall_attenuation = 10;
+
+        /** Floods the distances from @p source, up to @p max_distance. */
+        void flood( const tripoint &source, const int max_distance ) {
+            for( const int index : reached ) {
+                distances[index] = unreached;
+            }
+            reached.clear();
+            this->source = source;
+            const map &here = get_map();
+            if( !here.inbounds( source ) ) {
+                return;
+            }
+            if( distances.empty() ) {
+                distances.assign( MAPSIZE_X * MAPSIZE_Y, unreached );
+            }
+            const obstacle_array &obstacles = obstacles_on( source.z );
+
+            // Step costs are 1 or 1 + wall_attenuation, so a queue per cost would also do.
+            using entry = std::pair<int, point>;
+            std::priority_queue<entry, std::vector<entry>, pair_greater_cmp_first> open;
+            set_distance( source.xy(), 0 );
+            open.emplace( 0, source.xy() );
+            while( !open.empty() ) {
+                const int distance = open.top().first;
+                const point p = open.top().second;
+                open.pop();
+                if( distance > distances[index_of( p )] ) {
+                    continue;
+                }
+                for( const tripoint &offset : eight_horizontal_neighbors ) {
+                    const point dest = p + offset.xy();
+                    if( dest.x < 0 || dest.y < 0 || dest.x >= MAPSIZE_X || dest.y >= MAPSIZE_Y ) {
+                        continue;
+                    }
+                    const int cost = obstacles[dest.x][dest.y] > 0.0f ? 1 + wall_attenuation : 1;
+                    const int dest_distance = distance + cost;
+                    if( dest_distance <= max_distance &&
+                        dest_distance < distances[index_of( dest )] ) {
+                        set_distance( dest, dest_distance );
+                        open.emplace( dest_distance, dest );
+                    }
+                }
+            }
+        }
+
+        /**
+         * Like @ref sound_distance, but with the horizontal part as flooded by the last call to
+         * @ref flood. Returns INT_MAX for places the flood didn't reach.
+         */
+        int distance_to( const tripoint &sink ) const {
+            if( sink.x < 0 || sink.y < 0 || sink.x >= MAPSIZE_X || sink.y >= MAPSIZE_Y ||
+                distances.empty() ) {
+                return unreached;
+            }
+            const int horizontal = distances[index_of( sink.xy() )];
+            if( horizontal == unreached ) {
+                return unreached;
+            }
+            const int vertical = sound_distance( source, sink ) - rl_dist( source.xy(), sink.xy() );
+            return horizontal + vertical;
+        }
+
+    private:
+        using obstacle_array = float[MAPSIZE_X][MAPSIZE_Y];
+
+        struct obstacle_cache {
+            obstacle_array values = {};
+        };
+
+        static constexpr int unreached = std::numeric_limits<int>::max();
+
+        static int index_of( const point &p ) {
+            return p.x * MAPSIZE_Y + p.y;
+        }
+
+        void set_distance( const point &p, const int distance ) {
+            int &current = distances[index_of( p )];
+            if( current == unreached ) {
+                reached.push_back( index_of( p ) );
+            }
+            current = distance;
+        }
+
+        /** Obstacles of a z-level, built once per @ref sounds::process_sounds call. */
+        const obstacle_array &obstacles_on( const int z ) {
+            std::unique_ptr<obstacle_cache> &cache = obstacles[z + OVERMAP_DEPTH];
+            if( !cache ) {
+                cache = std::make_unique<obstacle_cache>();
+                map &here = get_map();
+                const tripoint_range<tripoint> area = here.points_on_zlevel( z );
+                here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east,
+                                           cache->values );
+            }
+            return cache->values;
+        }
+
+        std::array<std::unique_ptr<obstacle_cache>, OVERMAP_LAYERS> obstacles;
+        tripoint source;
+        std::vector<int> distances;
+        /** Indices into @ref distances set by the last flood. */
+        std::vector<int> reached;
+};
+
+} // namespace
+
 void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
+    if( sound_clusters.empty() ) {
+        return;
+    }
     const int weather_vol = get_weather().weather_id->sound_attn;
+    const bool propagate = get_option<bool>( "SOUND_PROPAGATION" );
+    sound_propagation propagation;
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -322,13 +452,24 @@ void sounds::process_sounds()
             const tripoint_abs_sm target( abs_sm, source.z );
             overmap_buffer.signal_hordes( target, sig_power );
         }
+        if( vol <= 0 ) {
+            continue;
+        }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        if( propagate ) {
+            propagation.flood( source, vol * 2 );
+        }
+        const std::vector<monster *> listeners =
+        g->critter_tracker->monsters_within( source, vol * 2, []( const monster & critter ) {
+            return critter.can_hear();
+        } );
+        for( monster *critter : listeners ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = propagate ? propagation.distance_to( critter->pos() ) :
+                             sound_distance( source, critter->pos() );
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+                critter->hear_sound( source, vol, dist );
             }
         }
     }
@@ -227,6 +227,21 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+void submap::compact_active_fields()
+{
+    const auto empty = [this]( const point & p ) {
+        if( fld[p.x][p.y].field_count() > 0 ) {
+            return false;
+        }
+        field_active.reset( p.x * SEEY + p.y );
+        return true;
+    };
+    active_fields.erase( std::remove_if( active_fields.begin(), active_fields.end(), empty ),
+                         active_fields.end() );
+    // x-major, same as the loops over the whole submap.
+    std::sort( active_fields.begin(), active_fields.end() );
+}
+
 void submap::rotate( int turns )
 {
     turns = turns % 4;
@@ -272,6 +287,12 @@ void submap::rotate( int turns )
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
 
+    field_active.reset();
+    for( point &p : active_fields ) {
+        p = rotate_point( p );
+        field_active.set( p.x * SEEY + p.y );
+    }
+
     for( auto &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
     }
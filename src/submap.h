@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -76,6 +77,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_trap( const point &p, trap_id trap ) {
             is_uniform = false;
+            dirty = true;
             trp[p.x][p.y] = trap;
         }
 
@@ -89,6 +91,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_furn( const point &p, furn_id furn ) {
             is_uniform = false;
+            dirty = true;
             frn[p.x][p.y] = furn;
         }
 
@@ -102,6 +105,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_ter( const point &p, ter_id terr ) {
             is_uniform = false;
+            dirty = true;
             ter[p.x][p.y] = terr;
         }
 
@@ -115,6 +119,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_radiation( const point &p, const int radiation ) {
             is_uniform = false;
+            dirty = true;
             rad[p.x][p.y] = radiation;
         }
 
@@ -124,11 +129,13 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_lum( const point &p, uint8_t luminance ) {
             is_uniform = false;
+            dirty = true;
             lum[p.x][p.y] = luminance;
         }
 
         void update_lum_add( const point &p, const item &i ) {
             is_uniform = false;
+            dirty = true;
             if( i.is_emissive() && lum[p.x][p.y] < 255 ) {
                 lum[p.x][p.y]++;
             }
@@ -136,6 +143,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void update_lum_rem( const point &p, const item &i ) {
             is_uniform = false;
+            dirty = true;
             if( !i.is_emissive() ) {
                 return;
             } else if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
@@ -221,16 +229,54 @@ class submap : maptile_soa<SEEX, SEEY>
         void set_computer( const point &p, const computer &c );
         void delete_computer( const point &p );
 
+        /**
+         * Adds the tile to the tiles field processing visits. Needs to be called whenever a
+         * field gets added to a tile without going through @ref map::add_field.
+         */
+        void mark_field_active( const point &p ) {
+            const size_t index = p.x * SEEY + p.y;
+            if( !field_active[index] ) {
+                field_active.set( index );
+                active_fields.push_back( p );
+            }
+        }
+        /** Whether the tile is in @ref get_active_fields. */
+        bool is_field_active( const point &p ) const {
+            return field_active[p.x * SEEY + p.y];
+        }
+        /**
+         * Tiles that had a field added since they were last found empty, see
+         * @ref compact_active_fields.
+         */
+        const std::vector<point> &get_active_fields() const {
+            return active_fields;
+        }
+        /**
+         * Drops the tiles whose fields are all gone from @ref get_active_fields and sorts the
+         * remaining ones in the order field processing used to visit the whole submap in.
+         */
+        void compact_active_fields();
+
         bool contains_vehicle( vehicle * );
 
         void rotate( int turns );
 
-        void store( JsonOut &jsout ) const;
+        /**
+         * Writes all members of the submap, or without its terrain, furniture, traps, radiation
+         * and fields if @p with_tile_layers is false (see @ref submap_binary).
+         */
+        void store( JsonOut &jsout, bool with_tile_layers = true ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version );
 
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
+        /**
+         * Whether the submap may differ from what was last written to disk, so saving can skip
+         * quads that haven't changed. Submaps in the reality bubble are modified through too
+         * many references to track, so they're always considered dirty while loaded.
+         */
+        bool dirty = true;
 
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
 
@@ -250,11 +296,16 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point_sm_ms, cata::poly_serialized<active_tile_data>> active_furniture;
 
     private:
+        std::vector<point> active_fields;
+        /** Which tiles are in @ref active_fields, indexed by x * SEEY + y. */
+        std::bitset<SEEX * SEEY> field_active;
+
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
 
         void update_legacy_computer();
+        void store_tile_layers( JsonOut &jsout ) const;
 
         static constexpr size_t elements = SEEX * SEEY;
 };
@@ -0,0 +1,288 @@
+#include "submap_binary.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "calendar.h"
+#include "field.h"
+#include "field_type.h"
+#include "game.h"
+#include "json.h"
+#include "mapdata.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace
+{
+
+constexpr char magic[4] = { 'C', 'B', 'N', 'Q' };
+
+class binary_writer
+{
+    public:
+        template<typename T>
+        void put( T value ) {
+            using U = std::make_unsigned_t<T>;
+            U bits = static_cast<U>( value );
+            for( size_t i = 0; i < sizeof( T ); ++i ) {
+                data.push_back( static_cast<char>( bits & 0xff ) );
+                bits = static_cast<U>( bits >> 8 );
+            }
+        }
+        void put( const std::string &str ) {
+            put( static_cast<std::uint32_t>( str.size() ) );
+            data += str;
+        }
+        /** Starts a block that's prefixed by its length in bytes, see @ref end_block. */
+        size_t start_block() {
+            put( std::uint32_t( 0 ) );
+            return data.size();
+        }
+        void end_block( const size_t start ) {
+            binary_writer length;
+            length.put( static_cast<std::uint32_t>( data.size() - start ) );
+            const size_t length_pos = start - sizeof( std::uint32_t );
+            std::copy( length.data.begin(), length.data.end(), data.begin() + length_pos );
+        }
+
+        std::string data;
+};
+
+class binary_reader
+{
+    public:
+        explicit binary_reader( const std::string &data ) : data( data ) { }
+
+        template<typename T>
+        T get() {
+            using U = std::make_unsigned_t<T>;
+            require( sizeof( T ) );
+            U bits = 0;
+            for( size_t i = 0; i < sizeof( T ); ++i ) {
+                const U byte = static_cast<unsigned char>( data[pos++] );
+                bits |= static_cast<U>( byte << ( 8 * i ) );
+            }
+            return static_cast<T>( bits );
+        }
+        std::string get_string() {
+            const size_t length = get<std::uint32_t>();
+            require( length );
+            std::string result = data.substr( pos, length );
+            pos += length;
+            return result;
+        }
+        /** Returns a reader for the next length-prefixed block and skips over it. */
+        binary_reader get_block() {
+            return binary_reader( get_string() );
+        }
+        bool at_end() const {
+            return pos == data.size();
+        }
+
+    private:
+        void require( const size_t bytes ) const {
+            if( data.size() - pos < bytes ) {
+                throw std::runtime_error( "binary map data is truncated" );
+            }
+        }
+
+        std::string data;
+        size_t pos = 0;
+};
+
+/** Ids used in a quad, in the order they were first seen. */
+class id_table
+{
+    public:
+        std::uint16_t index( const std::string &id ) {
+            const auto iter = indices.emplace( id, ids.size() );
+            if( iter.second ) {
+                ids.push_back( id );
+            }
+            return iter.first->second;
+        }
+
+        std::vector<std::string> ids;
+
+    private:
+        std::unordered_map<std::string, std::uint16_t> indices;
+};
+
+const std::string &lookup( const std::vector<std::string> &ids, const std::uint16_t index )
+{
+    if( index >= ids.size() ) {
+        throw std::runtime_error( string_format( "binary map data refers to id %d of %d", index,
+                                  static_cast<int>( ids.size() ) ) );
+    }
+    return ids[index];
+}
+
+void write_submap( binary_writer &out, id_table &ids, const tripoint &pos, const submap &sm )
+{
+    out.put( static_cast<std::int32_t>( pos.x ) );
+    out.put( static_cast<std::int32_t>( pos.y ) );
+    out.put( static_cast<std::int32_t>( pos.z ) );
+    out.put( static_cast<std::int32_t>( savegame_version ) );
+
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            out.put( ids.index( sm.get_ter( { i, j } ).id().str() ) );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            out.put( ids.index( sm.get_furn( { i, j } ).id().str() ) );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            out.put( ids.index( sm.get_trap( { i, j } ).id().str() ) );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            out.put( static_cast<std::int32_t>( sm.get_radiation( { i, j } ) ) );
+        }
+    }
+
+    const size_t fields = out.start_block();
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            for( const auto &elem : sm.get_field( { i, j } ) ) {
+                const field_entry &cur = elem.second;
+                out.put( static_cast<std::uint8_t>( i ) );
+                out.put( static_cast<std::uint8_t>( j ) );
+                out.put( ids.index( cur.get_field_type().id().str() ) );
+                out.put( static_cast<std::int32_t>( cur.get_field_intensity() ) );
+                out.put( static_cast<std::int32_t>( to_turns<int>( cur.get_field_age() ) ) );
+            }
+        }
+    }
+    out.end_block( fields );
+
+    std::ostringstream rest;
+    JsonOut jsout( rest );
+    jsout.start_object();
+    sm.store( jsout, false );
+    jsout.end_object();
+    out.put( rest.str() );
+}
+
+std::unique_ptr<submap> read_submap( binary_reader &in, const std::vector<std::string> &ids,
+                                     tripoint &pos )
+{
+    pos.x = in.get<std::int32_t>();
+    pos.y = in.get<std::int32_t>();
+    pos.z = in.get<std::int32_t>();
+    const int version = in.get<std::int32_t>();
+
+    std::unique_ptr<submap> sm = std::make_unique<submap>();
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            sm->set_ter( { i, j }, ter_str_id( lookup( ids, in.get<std::uint16_t>() ) ).id() );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            sm->set_furn( { i, j }, furn_str_id( lookup( ids, in.get<std::uint16_t>() ) ).id() );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            sm->set_trap( { i, j }, trap_str_id( lookup( ids, in.get<std::uint16_t>() ) ).id() );
+        }
+    }
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            sm->set_radiation( { i, j }, in.get<std::int32_t>() );
+        }
+    }
+
+    binary_reader fields = in.get_block();
+    while( !fields.at_end() ) {
+        const int i = fields.get<std::uint8_t>();
+        const int j = fields.get<std::uint8_t>();
+        const field_type_id ft( lookup( ids, fields.get<std::uint16_t>() ) );
+        const int intensity = fields.get<std::int32_t>();
+        const int age = fields.get<std::int32_t>();
+        if( i >= SEEX || j >= SEEY ) {
+            throw std::runtime_error( "binary map data has a field outside of its submap" );
+        }
+        field &fld = sm->get_field( { i, j } );
+        if( fld.find_field( ft ) == nullptr ) {
+            sm->field_count++;
+        }
+        fld.add_field( ft, intensity, time_duration::from_turns( age ) );
+        sm->mark_field_active( { i, j } );
+    }
+
+    std::istringstream rest( in.get_string() );
+    JsonIn jsin( rest );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string member_name = jsin.get_member_name();
+        sm->load( jsin, member_name, version );
+    }
+    return sm;
+}
+
+} // namespace
+
+namespace submap_binary
+{
+
+void write_quad( std::ostream &fout, const std::vector<std::pair<tripoint, const submap *>> &submaps )
+{
+    id_table ids;
+    binary_writer body;
+    body.put( static_cast<std::uint32_t>( submaps.size() ) );
+    for( const auto &elem : submaps ) {
+        write_submap( body, ids, elem.first, *elem.second );
+    }
+
+    binary_writer header;
+    header.data.assign( std::begin( magic ), std::end( magic ) );
+    header.put( format_version );
+    header.put( static_cast<std::uint32_t>( ids.ids.size() ) );
+    for( const std::string &id : ids.ids ) {
+        header.put( id );
+    }
+    fout.write( header.data.data(), header.data.size() );
+    fout.write( body.data.data(), body.data.size() );
+}
+
+quad read_quad( std::istream &fin )
+{
+    const std::string data( ( std::istreambuf_iterator<char>( fin ) ),
+                            std::istreambuf_iterator<char>() );
+    if( data.size() < sizeof( magic ) || !std::equal( std::begin( magic ), std::end( magic ),
+            data.begin() ) ) {
+        throw std::runtime_error( "not a binary map file" );
+    }
+    binary_reader in( data.substr( sizeof( magic ) ) );
+    const std::uint32_t version = in.get<std::uint32_t>();
+    if( version != format_version ) {
+        throw std::runtime_error( string_format( "binary map format version %d is not supported",
+                                  version ) );
+    }
+    std::vector<std::string> ids;
+    for( std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count ) {
+        ids.push_back( in.get_string() );
+    }
+
+    quad result;
+    for( std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count ) {
+        tripoint pos;
+        std::unique_ptr<submap> sm = read_submap( in, ids, pos );
+        result.emplace_back( pos, std::move( sm ) );
+    }
+    return result;
+}
+
+} // namespace submap_binary
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef CATA_SRC_SUBMAP_BINARY_H
+#define CATA_SRC_SUBMAP_BINARY_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Binary alternative to the JSON quad files in the `maps/` directory, used when the
+ * "BINARY_MAPS" world option is enabled.
+ *
+ * A quad file starts with a header and a table of all the ids it uses. Every submap then has
+ * its terrain, furniture and traps as fixed size arrays of indices into that table, its
+ * radiation as a fixed size array, followed by a length-prefixed binary block of its fields
+ * and a length-prefixed JSON object with everything else (items, vehicles, etc.), as written
+ * by @ref submap::store. All numbers are little endian.
+ */
+namespace submap_binary
+{
+
+/** Bumped whenever the layout changes, files with any other version are refused. */
+constexpr std::uint32_t format_version = 1;
+
+using quad = std::vector<std::pair<tripoint, std::unique_ptr<submap>>>;
+
+void write_quad( std::ostream &fout, const std::vector<std::pair<tripoint, const submap *>> &submaps );
+/** @throw std::exception if the data is truncated, corrupted or of an unknown version. */
+quad read_quad( std::istream &fin );
+
+} // namespace submap_binary
+
+#endif // CATA_SRC_SUBMAP_BINARY_H
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef CATA_SRC_TILE_LOOKUP_CACHE_H
+#define CATA_SRC_TILE_LOOKUP_CACHE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "calendar.h"
+
+/**
+ * Results of a tile lookup by int_id, as done by cata_tiles for terrain and furniture.
+ *
+ * Tilesets can have seasonal variants of a tile, so the results are only kept for one season:
+ * asking for another season drops everything found so far. The owner has to @ref clear the
+ * cache itself when the tileset or the ids change.
+ */
+template<typename Value>
+class tile_lookup_cache
+{
+    public:
+        /**
+         * The value found for @p index in @p season. On the first request since the last
+         * clear, it's taken from @p lookup, which is called without arguments.
+         */
+        template<typename Lookup>
+        const Value &get( const season_type season, const size_t index, Lookup lookup ) {
+            if( season != cached_season ) {
+                clear();
+                cached_season = season;
+            }
+            if( index >= entries.size() ) {
+                entries.resize( index + 1 );
+            }
+            entry &found = entries[index];
+            if( !found.resolved ) {
+                found.value = lookup();
+                found.resolved = true;
+            }
+            return found.value;
+        }
+
+        void clear() {
+            entries.clear();
+            cached_season = season_type::NUM_SEASONS;
+        }
+
+    private:
+        struct entry {
+            bool resolved = false;
+            Value value{};
+        };
+
+        season_type cached_season = season_type::NUM_SEASONS;
+        std::vector<entry> entries;
+};
+
+#endif // CATA_SRC_TILE_LOOKUP_CACHE_H
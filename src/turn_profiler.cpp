@@ -0,0 +1,224 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+#include "json.h"
+#include "string_formatter.h"
+
+namespace turn_profiler
+{
+
+namespace
+{
+
+/** One run of a phase, kept for the trace export. */
+struct event {
+    phase_id id;
+    int turn;
+    clock_type::time_point start;
+    clock_type::time_point end;
+};
+
+/** At most this many events are kept, older ones get overwritten. */
+constexpr size_t max_events = 1 << 16;
+
+struct phase_data {
+    std::string name;
+    /** Time spent in the phase during the current turn. */
+    clock_type::duration current = clock_type::duration::zero();
+    bool ran = false;
+    /** Time spent per turn in nanoseconds, negative for turns in which it didn't run. */
+    std::array<std::int64_t, history_size> history;
+
+    explicit phase_data( const char *name ) : name( name ) {
+        history.fill( -1 );
+    }
+};
+
+struct profiler_state {
+    bool enabled = false;
+    std::vector<phase_data> phases;
+    /** Ring buffer of the latest events, @ref next_event is the oldest once it's full. */
+    std::vector<event> events;
+    size_t next_event = 0;
+    /** Slot in the histories the current turn goes to. */
+    int next_slot = 0;
+    int recorded_turns = 0;
+    int turn = 0;
+    clock_type::time_point epoch;
+};
+
+profiler_state &state()
+{
+    static profiler_state instance;
+    return instance;
+}
+
+std::int64_t to_ns( const clock_type::duration &d )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( d ).count();
+}
+
+double to_us( const std::int64_t ns )
+{
+    return ns / 1000.0;
+}
+
+double to_us( const clock_type::duration &d )
+{
+    return to_us( to_ns( d ) );
+}
+
+} // namespace
+
+phase_id register_phase( const char *name )
+{
+    std::vector<phase_data> &phases = state().phases;
+    const auto iter = std::find_if( phases.begin(), phases.end(), [name]( const phase_data & p ) {
+        return p.name == name;
+    } );
+    if( iter != phases.end() ) {
+        return static_cast<phase_id>( iter - phases.begin() );
+    }
+    phases.emplace_back( name );
+    return static_cast<phase_id>( phases.size() - 1 );
+}
+
+bool enabled()
+{
+    return state().enabled;
+}
+
+void set_enabled( const bool enable )
+{
+    profiler_state &s = state();
+    if( enable && !s.enabled ) {
+        for( phase_data &p : s.phases ) {
+            p.current = clock_type::duration::zero();
+            p.ran = false;
+            p.history.fill( -1 );
+        }
+        s.events.clear();
+        s.events.reserve( max_events );
+        s.next_event = 0;
+        s.next_slot = 0;
+        s.recorded_turns = 0;
+        s.turn = 0;
+        s.epoch = clock_type::now();
+    }
+    s.enabled = enable;
+}
+
+void record( const phase_id id, const clock_type::time_point start, const clock_type::time_point end )
+{
+    profiler_state &s = state();
+    phase_data &p = s.phases[id];
+    p.current += end - start;
+    p.ran = true;
+
+    const event ev{ id, s.turn, start, end };
+    if( s.events.size() < max_events ) {
+        s.events.push_back( ev );
+    } else {
+        s.events[s.next_event] = ev;
+        s.next_event = ( s.next_event + 1 ) % max_events;
+    }
+}
+
+void end_turn()
+{
+    profiler_state &s = state();
+    if( !s.enabled ) {
+        return;
+    }
+    for( phase_data &p : s.phases ) {
+        p.history[s.next_slot] = p.ran ? to_ns( p.current ) : -1;
+        p.current = clock_type::duration::zero();
+        p.ran = false;
+    }
+    s.next_slot = ( s.next_slot + 1 ) % history_size;
+    s.recorded_turns = std::min( s.recorded_turns + 1, history_size );
+    s.turn++;
+}
+
+std::vector<phase_stats> get_stats()
+{
+    const profiler_state &s = state();
+    std::vector<phase_stats> result;
+    std::vector<std::int64_t> times;
+    for( const phase_data &p : s.phases ) {
+        times.clear();
+        // Slot order doesn't matter here, only which slots have been filled yet.
+        for( int slot = 0; slot < s.recorded_turns; ++slot ) {
+            if( p.history[slot] >= 0 ) {
+                times.push_back( p.history[slot] );
+            }
+        }
+        if( times.empty() ) {
+            continue;
+        }
+        std::sort( times.begin(), times.end() );
+        phase_stats stats;
+        stats.name = p.name;
+        stats.turns = times.size();
+        stats.min = to_us( times.front() );
+        std::int64_t total = 0;
+        for( const std::int64_t t : times ) {
+            total += t;
+        }
+        stats.avg = to_us( total ) / times.size();
+        const size_t p99_index = static_cast<size_t>( std::ceil( times.size() * 0.99 ) ) - 1;
+        stats.p99 = to_us( times[p99_index] );
+        result.push_back( stats );
+    }
+    std::sort( result.begin(), result.end(), []( const phase_stats & a, const phase_stats & b ) {
+        return a.avg > b.avg;
+    } );
+    return result;
+}
+
+std::string format_stats()
+{
+    std::string result = string_format( "Last %d turns, in microseconds per turn:\n\n",
+                                        state().recorded_turns );
+    result += string_format( "%-28s %6s %10s %10s %10s\n", "phase", "turns", "min", "avg", "p99" );
+    for( const phase_stats &stats : get_stats() ) {
+        result += string_format( "%-28s %6d %10.1f %10.1f %10.1f\n", stats.name, stats.turns,
+                                 stats.min, stats.avg, stats.p99 );
+    }
+    return result;
+}
+
+void write_chrome_trace( std::ostream &fout )
+{
+    const profiler_state &s = state();
+    JsonOut jsout( fout, true );
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    for( size_t i = 0; i < s.events.size(); ++i ) {
+        const event &ev = s.events[( s.next_event + i ) % s.events.size()];
+        jsout.start_object();
+        jsout.member( "name", s.phases[ev.id].name );
+        jsout.member( "cat", "turn" );
+        jsout.member( "ph", "X" );
+        jsout.member( "ts", to_us( ev.start - s.epoch ) );
+        jsout.member( "dur", to_us( ev.end - ev.start ) );
+        jsout.member( "pid", 1 );
+        jsout.member( "tid", 1 );
+        jsout.member( "args" );
+        jsout.start_object();
+        jsout.member( "turn", ev.turn );
+        jsout.end_object();
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+} // namespace turn_profiler
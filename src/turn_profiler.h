@@ -0,0 +1,95 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Measures how long the phases of @ref game::do_turn take, to find out which of them blows the
+ * turn budget on a given save. Toggled, shown and exported from the debug menu.
+ *
+ * A phase is marked with @ref CATA_TURN_PHASE, which times the rest of the enclosing scope.
+ * Nothing gets measured while the profiler is disabled, and building with
+ * CATA_NO_TURN_PROFILER defined removes the markers entirely.
+ */
+namespace turn_profiler
+{
+
+using clock_type = std::chrono::steady_clock;
+/** Index of a phase, as returned by @ref register_phase. */
+using phase_id = int;
+
+/** Number of turns the statistics are collected over. */
+constexpr int history_size = 512;
+
+/** Returns the id of the phase with that name, adding it if needed. */
+phase_id register_phase( const char *name );
+
+bool enabled();
+/** Enabling the profiler drops everything recorded earlier. */
+void set_enabled( bool enable );
+
+/** Adds the time spent in a phase to the current turn. */
+void record( phase_id id, clock_type::time_point start, clock_type::time_point end );
+/** Files everything recorded since the last call under one turn. Called once per turn. */
+void end_turn();
+
+struct phase_stats {
+    std::string name;
+    /** Number of recorded turns in which the phase ran at all. */
+    int turns = 0;
+    /** Time spent per turn in microseconds, over the turns in which the phase ran. */
+    double min = 0.0;
+    double avg = 0.0;
+    double p99 = 0.0;
+};
+/** Statistics of all phases that ran in the recorded turns, slowest average first. */
+std::vector<phase_stats> get_stats();
+std::string format_stats();
+
+/** Writes the recorded phases as Chrome trace events, viewable in chrome://tracing. */
+void write_chrome_trace( std::ostream &fout );
+
+class scoped_phase
+{
+    public:
+        explicit scoped_phase( const phase_id id ) : id( id ), running( enabled() ) {
+            if( running ) {
+                start = clock_type::now();
+            }
+        }
+        ~scoped_phase() {
+            if( running ) {
+                record( id, start, clock_type::now() );
+            }
+        }
+
+        scoped_phase( const scoped_phase & ) = delete;
+        scoped_phase &operator=( const scoped_phase & ) = delete;
+
+    private:
+        phase_id id;
+        bool running;
+        clock_type::time_point start;
+};
+
+} // namespace turn_profiler
+
+#define CATA_TURN_PHASE_CONCAT_IMPL( a, b ) a##b
+#define CATA_TURN_PHASE_CONCAT( a, b ) CATA_TURN_PHASE_CONCAT_IMPL( a, b )
+
+#if defined(CATA_NO_TURN_PROFILER)
+#define CATA_TURN_PHASE( name ) static_cast<void>( 0 )
+#else
+/** Times the rest of the enclosing scope as the phase @p name, which must be a string literal. */
+#define CATA_TURN_PHASE( name ) \
+    static const turn_profiler::phase_id CATA_TURN_PHASE_CONCAT( turn_phase_id_, __LINE__ ) = \
+            turn_profiler::register_phase( name ); \
+    const turn_profiler::scoped_phase CATA_TURN_PHASE_CONCAT( turn_phase_, __LINE__ )( \
+            CATA_TURN_PHASE_CONCAT( turn_phase_id_, __LINE__ ) )
+#endif
+
+#endif // CATA_SRC_TURN_PROFILER_H
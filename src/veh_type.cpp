@@ -517,26 +517,40 @@ void vpart_info::finalize()
             e.second.z_order = 0;
             e.second.list_order = 5;
         }
-    }
-}
-
-void vpart_info::check()
-{
-    for( auto &vp : vpart_info_all ) {
-        auto &part = vp.second;
 
         // add the base item to the installation requirements
         // TODO: support multiple/alternative base items
         requirement_data ins;
-        ins.components.push_back( { { { part.item, 1 } } } );
+        ins.components.push_back( { { { e.second.item, 1 } } } );
 
-        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + part.id.str() );
+        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + e.second.id.str() );
         requirement_data::save_requirement( ins, ins_id );
-        part.install_reqs.emplace_back( ins_id, 1 );
+        e.second.install_reqs.emplace_back( ins_id, 1 );
 
-        if( part.removal_moves < 0 ) {
-            part.removal_moves = part.install_moves / 2;
+        if( e.second.removal_moves < 0 ) {
+            e.second.removal_moves = e.second.install_moves / 2;
+        }
+
+        // Fuel type errors are serious and need fixing now
+        if( !e.second.fuel_type.is_valid() ) {
+            debugmsg( "vehicle part %s uses undefined fuel %s", e.second.id.c_str(),
+                      e.second.item.c_str() );
+            e.second.fuel_type = itype_id::NULL_ID();
+        } else if( e.second.fuel_type && !e.second.fuel_type->fuel && e.second.item.is_valid() &&
+                   ( !e.second.item->container || !e.second.item->container->watertight ) ) {
+            // HACK: Tanks are allowed to specify non-fuel "fuel",
+            // because currently legacy blazemod uses it as a hack to restrict content types
+            debugmsg( "non-tank vehicle part %s uses non-fuel item %s as fuel, setting to null",
+                      e.second.id.c_str(), e.second.fuel_type.c_str() );
+            e.second.fuel_type = itype_id::NULL_ID();
         }
+    }
+}
+
+void vpart_info::check()
+{
+    for( const auto &vp : vpart_info_all ) {
+        const vpart_info &part = vp.second;
 
         for( auto &e : part.install_skills ) {
             if( !e.first.is_valid() ) {
@@ -617,18 +631,6 @@ void vpart_info::check()
             debugmsg( "vehicle part %s uses undefined item %s", part.id.c_str(), part.item.c_str() );
         }
         const itype &base_item_type = *part.item;
-        // Fuel type errors are serious and need fixing now
-        if( !part.fuel_type.is_valid() ) {
-            debugmsg( "vehicle part %s uses undefined fuel %s", part.id.c_str(), part.item.c_str() );
-            part.fuel_type = itype_id::NULL_ID();
-        } else if( part.fuel_type && !part.fuel_type->fuel &&
-                   ( !base_item_type.container || !base_item_type.container->watertight ) ) {
-            // HACK: Tanks are allowed to specify non-fuel "fuel",
-            // because currently legacy blazemod uses it as a hack to restrict content types
-            debugmsg( "non-tank vehicle part %s uses non-fuel item %s as fuel, setting to null",
-                      part.id.c_str(), part.fuel_type.c_str() );
-            part.fuel_type = itype_id::NULL_ID();
-        }
         if( part.has_flag( "TURRET" ) && !base_item_type.gun ) {
             debugmsg( "vehicle part %s has the TURRET flag, but is not made from a gun item", part.id.c_str() );
         }
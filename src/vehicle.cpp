@@ -2425,14 +2425,35 @@ std::vector<int> vehicle::parts_at_relative( const point &dp,
         }
         return res;
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            return iter->second;
-        } else {
-            std::vector<int> res;
-            return res;
-        }
+        const std::vector<int> *parts_here = relative_parts_at( dp );
+        return parts_here != nullptr ? *parts_here : std::vector<int>();
+    }
+}
+
+const std::vector<int> *vehicle::relative_parts_at( const point &dp ) const
+{
+    const point rel = dp - relative_parts_min;
+    if( rel.x < 0 || rel.y < 0 || rel.x >= relative_parts_size.x ||
+        rel.y >= relative_parts_size.y ) {
+        return nullptr;
+    }
+    const std::vector<int> &parts_here = relative_parts[rel.x * relative_parts_size.y + rel.y];
+    return parts_here.empty() ? nullptr : &parts_here;
+}
+
+bool vehicle::part_indices_valid() const
+{
+    return !parts_by_flag.empty() && indexed_part_count == parts.size();
+}
+
+size_t vehicle::next_part_with_flag( const size_t p, const vpart_bitflags f ) const
+{
+    if( !part_indices_valid() ) {
+        return p;
     }
+    const std::vector<int> &with_flag = parts_by_flag[f];
+    const auto iter = std::lower_bound( with_flag.begin(), with_flag.end(), static_cast<int>( p ) );
+    return iter != with_flag.end() ? *iter : parts.size();
 }
 
 cata::optional<vpart_reference> vpart_position::obstacle_at_part() const
@@ -2505,10 +2526,8 @@ int vehicle::part_with_feature( int part, vpart_bitflags const flag, bool unbrok
     if( part_flag( part, flag ) && ( !unbroken || !parts[part].is_broken() ) ) {
         return part;
     }
-    const auto it = relative_parts.find( parts[part].mount );
-    if( it != relative_parts.end() ) {
-        const std::vector<int> &parts_here = it->second;
-        for( auto &i : parts_here ) {
+    if( const std::vector<int> *parts_here = relative_parts_at( parts[part].mount ) ) {
+        for( const int i : *parts_here ) {
             if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
                 return i;
             }
@@ -2524,6 +2543,19 @@ int vehicle::part_with_feature( int part, const std::string &flag, bool unbroken
 
 int vehicle::part_with_feature( const point &pt, const std::string &flag, bool unbroken ) const
 {
+    if( part_indices_valid() ) {
+        // The cached parts are in display order, but this returns the first matching index.
+        int result = -1;
+        if( const std::vector<int> *parts_here = relative_parts_at( pt ) ) {
+            for( const int elem : *parts_here ) {
+                if( ( result < 0 || elem < result ) && !parts[elem].removed &&
+                    part_flag( elem, flag ) && ( !unbroken || !parts[elem].is_broken() ) ) {
+                    result = elem;
+                }
+            }
+        }
+        return result;
+    }
     std::vector<int> parts_here = parts_at_relative( pt, false );
     for( auto &elem : parts_here ) {
         if( part_flag( elem, flag ) && ( !unbroken || !parts[ elem ].is_broken() ) ) {
@@ -3808,7 +3840,7 @@ void vehicle::spew_field( double joules, int part, field_type_id type, int inten
     point p = parts[part].mount;
     intensity = std::max( joules / 10000, static_cast<double>( intensity ) );
     // Move back from engine/muffler until we find an open space
-    while( relative_parts.find( p ) != relative_parts.end() ) {
+    while( relative_parts_at( p ) != nullptr ) {
         p.x += ( velocity < 0 ? 1 : -1 );
     }
     point q = coord_translate( p );
@@ -4871,7 +4903,7 @@ void vehicle::power_parts()
             vp.part().enabled = false;
         }
         // Rechargers need special case since they consume power on demand
-        for( const vpart_reference &vp : get_enabled_parts( "RECHARGE" ) ) {
+        for( const vpart_reference &vp : get_enabled_parts( VPFLAG_RECHARGE ) ) {
             vp.part().enabled = false;
         }
 
@@ -4917,6 +4949,8 @@ vehicle *vehicle::find_vehicle( const tripoint &where )
     for( auto &elem : sm->vehicles ) {
         vehicle *found_veh = elem.get();
         if( veh_in_sm.xy() == found_veh->pos ) {
+            // The caller may modify it outside of the reality bubble.
+            sm->dirty = true;
             return found_veh;
         }
     }
@@ -5668,7 +5702,6 @@ void vehicle::refresh()
     water_wheels.clear();
     funnels.clear();
     emitters.clear();
-    relative_parts.clear();
     loose_parts.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
@@ -5692,6 +5725,39 @@ void vehicle::refresh()
     mount_min.y = 123;
     mount_max.x = -123;
     mount_max.y = -123;
+    for( const vehicle_part &vp : parts ) {
+        if( !vp.removed ) {
+            mount_min.x = std::min( mount_min.x, vp.mount.x );
+            mount_min.y = std::min( mount_min.y, vp.mount.y );
+            mount_max.x = std::max( mount_max.x, vp.mount.x );
+            mount_max.y = std::max( mount_max.y, vp.mount.y );
+        }
+    }
+
+    // Index the parts by mount point and by flag first, the main loop already looks them up.
+    relative_parts_min = mount_min;
+    relative_parts_size = point( std::max( mount_max.x - mount_min.x + 1, 0 ),
+                                 std::max( mount_max.y - mount_min.y + 1, 0 ) );
+    relative_parts.assign( relative_parts_size.x * relative_parts_size.y, std::vector<int>() );
+    parts_by_flag.assign( NUM_VPFLAGS, std::vector<int>() );
+    for( size_t p = 0; p < parts.size(); ++p ) {
+        if( parts[p].removed ) {
+            continue;
+        }
+        // This will keep the parts at each point sorted
+        const point rel = parts[p].mount - relative_parts_min;
+        std::vector<int> &parts_here = relative_parts[rel.x * relative_parts_size.y + rel.y];
+        parts_here.insert( std::lower_bound( parts_here.begin(), parts_here.end(),
+                                             static_cast<int>( p ), svpv ), p );
+
+        const vpart_info &vpi = parts[p].info();
+        for( int f = 0; f < NUM_VPFLAGS; ++f ) {
+            if( vpi.has_flag( static_cast<vpart_bitflags>( f ) ) ) {
+                parts_by_flag[f].push_back( p );
+            }
+        }
+    }
+    indexed_part_count = parts.size();
 
     bool refresh_done = false;
 
@@ -5703,19 +5769,7 @@ void vehicle::refresh()
             continue;
         }
         refresh_done = true;
-
-        // Build map of point -> all parts in that point
         const point pt = vp.mount();
-        mount_min.x = std::min( mount_min.x, pt.x );
-        mount_min.y = std::min( mount_min.y, pt.y );
-        mount_max.x = std::max( mount_max.x, pt.x );
-        mount_max.y = std::max( mount_max.y, pt.y );
-
-        // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
-                                         static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
 
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
@@ -6974,6 +7028,8 @@ void vehicle::invalidate_mass()
     pivot_dirty = true;
     coeff_rolling_dirty = true;
     coeff_water_dirty = true;
+    // So do the cargo and the fuel crafting can use
+    map::resource_changes++;
 }
 
 void vehicle::refresh_mass() const
@@ -7154,6 +7210,18 @@ bool vehicle_part_with_feature_range<std::string>::matches( const size_t part )
            ( !( part_status_flag::enabled & required_ ) || vp.enabled );
 }
 
+template<>
+size_t vehicle_part_with_feature_range<std::string>::first_candidate( const size_t part ) const
+{
+    return part;
+}
+
+template<>
+size_t vehicle_part_with_feature_range<vpart_bitflags>::first_candidate( const size_t part ) const
+{
+    return this->vehicle().next_part_with_flag( part, feature_ );
+}
+
 template<>
 bool vehicle_part_with_feature_range<vpart_bitflags>::matches( const size_t part ) const
 {
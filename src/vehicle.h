@@ -991,6 +991,13 @@ class vehicle
         // returns the list of indices of parts at certain position (not accounting frame direction)
         std::vector<int> parts_at_relative( const point &dp, bool use_cache ) const;
 
+        /**
+         * Returns the index of the first part at or after @p p that might have flag @p f, or
+         * part_count() if there is none. Skips the parts that didn't have the flag when the
+         * vehicle was last refreshed, the caller still has to check the part itself.
+         */
+        size_t next_part_with_flag( size_t p, vpart_bitflags f ) const;
+
         // returns index of part, inner to given, with certain flag, or -1
         int part_with_feature( int p, const std::string &f, bool unbroken ) const;
         int part_with_feature( const point &pt, const std::string &f, bool unbroken ) const;
@@ -1853,8 +1860,11 @@ class vehicle
          * spawned with the default constructor).
          */
         vproto_id type;
-        // parts_at_relative(dp) is used a lot (to put it mildly)
-        std::map<point, std::vector<int>> relative_parts;
+        // parts_at_relative(dp) is used a lot (to put it mildly), so the parts at each mount point
+        // are kept in a dense grid over the bounding box of the mounts, see relative_parts_at
+        std::vector<std::vector<int>> relative_parts;
+        point relative_parts_min;
+        point relative_parts_size;
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -1952,6 +1962,17 @@ class vehicle
     private:
         bool no_refresh = false;
 
+        // Parts at the mount point dp, or nullptr if there are none.
+        const std::vector<int> *relative_parts_at( const point &dp ) const;
+        // Whether relative_parts and parts_by_flag still cover all parts. Parts can get added
+        // or erased without a refresh, e.g. while refresh is suspended.
+        bool part_indices_valid() const;
+        // Indices of the parts with each vpart_bitflags flag, in increasing order. Like the
+        // lists above they exclude removed parts and are rebuilt by refresh().
+        std::vector<std::vector<int>> parts_by_flag;
+        // Part count at the time relative_parts and parts_by_flag were built.
+        size_t indexed_part_count = 0;
+
         // if true, pivot_cache needs to be recalculated
         mutable bool pivot_dirty = true;
         mutable bool mass_dirty = true;
@@ -255,6 +255,7 @@ int vehicle_part::ammo_remaining() const
 int vehicle_part::ammo_set( const itype_id &ammo, int qty )
 {
     const itype *liquid = &*ammo;
+    map::resource_changes++;
 
     // We often check if ammo is set to see if tank is empty, if qty == 0 don't set ammo
     if( is_tank() && liquid->phase >= LIQUID && qty != 0 ) {
@@ -288,6 +289,8 @@ void vehicle_part::ammo_unset()
 
 int vehicle_part::ammo_consume( int qty, const tripoint &pos )
 {
+    // Fuel and battery charge can be crafted with
+    map::resource_changes++;
     if( is_tank() && !base.contents.empty() ) {
         const int res = std::min( ammo_remaining(), qty );
         item &liquid = base.contents.back();
@@ -317,6 +320,7 @@ double vehicle_part::consume_energy( const itype_id &ftype, double energy_j )
         if( !charges_to_use ) {
             return 0.0;
         }
+        map::resource_changes++;
         if( charges_to_use >= fuel.charges ) {
             charges_to_use = fuel.charges;
             base.contents.clear_items();
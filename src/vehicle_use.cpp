@@ -1544,9 +1544,11 @@ void vehicle::open_or_close( const int part_index, const bool opening )
         sfx::play_variant_sound( opening ? "vehicle_open" : "vehicle_close",
                                  parts[ part_index ].info().get_id().str(), 100 - dist * 3 );
     }
+    here.set_pathfinding_cache_dirty( part_location );
     for( auto const &vec : find_lines_of_parts( part_index, "OPENABLE" ) ) {
         for( auto const &partID : vec ) {
             parts[partID].open = opening;
+            here.set_pathfinding_cache_dirty( global_part_pos3( partID ) );
         }
     }
 
@@ -740,6 +740,7 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
             // finally remove the item
             res.push_back( *iter );
             iter = stack.erase( iter );
+            map::resource_changes++;
 
             if( --count == 0 ) {
                 return res;
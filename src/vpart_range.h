@@ -32,9 +32,10 @@ class vehicle_part_iterator
             return range_.get();
         }
         void skip_to_next_valid( size_t i ) {
+            i = range().first_candidate( i );
             while( i < range().part_count() &&
                    !range().matches( i ) ) {
-                ++i;
+                i = range().first_candidate( i + 1 );
             }
             if( i < range().part_count() ) {
                 vp_.emplace( range().vehicle(), i );
@@ -92,10 +93,12 @@ template<class T> struct iterator_traits<vehicle_part_iterator<T>> {
 } // namespace std
 
 /**
- * The generic range, it misses the `bool contained(size_t)` function that is
+ * The generic range, it misses the `bool matches(size_t)` function that is
  * required by the iterator class. You need to derive from it and implement
  * that function. It uses the curiously recurring template pattern (CRTP),
  * so use your derived range class as @ref range_type.
+ * The derived class can also hide `size_t first_candidate(size_t)`, to let the
+ * iterator skip parts that can't match without checking each of them.
  */
 template<typename range_type>
 class generic_vehicle_part_range
@@ -112,6 +115,11 @@ class generic_vehicle_part_range
             return static_cast<const T &>( vehicle_.get() ).part_count();
         }
 
+        // The first part at or after @p part that might match.
+        size_t first_candidate( const size_t part ) const {
+            return part;
+        }
+
         using iterator = vehicle_part_iterator<range_type>;
         iterator begin() const {
             return iterator( const_cast<range_type &>( static_cast<const range_type &>( *this ) ), 0 );
@@ -165,6 +173,7 @@ class vehicle_part_with_feature_range : public
                     feature_( std::move( f ) ), required_( r ) { }
 
         bool matches( size_t part ) const;
+        size_t first_candidate( size_t part ) const;
 };
 
 #endif // CATA_SRC_VPART_RANGE_H
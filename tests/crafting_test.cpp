@@ -19,6 +19,7 @@
 #include "crafting.h"
 #include "distribution_grid.h"
 #include "game.h"
+#include "inventory.h"
 #include "item.h"
 #include "itype.h"
 #include "map.h"
@@ -35,8 +36,7 @@
 #include "string_id.h"
 #include "type_id.h"
 #include "value_ptr.h"
-
-class inventory;
+#include "vehicle.h"
 
 static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
 static const trait_id trait_DEBUG_STORAGE( "DEBUG_STORAGE" );
@@ -693,6 +693,59 @@ TEST_CASE( "oven electric grid", "[crafting][overmap][grids][slow]" )
     }
 }
 
+TEST_CASE( "crafting_inventory_follows_map_changes", "[crafting]" )
+{
+    map &m = get_map();
+    avatar &u = get_avatar();
+    const tripoint start_pos( 60, 60, 0 );
+    u.setpos( start_pos );
+    clear_avatar();
+    clear_map();
+    const itype_id pot( "pot" );
+    const itype_id pan( "pan" );
+    u.invalidate_crafting_inventory();
+    REQUIRE_FALSE( u.crafting_inventory().has_amount( pot, 1 ) );
+
+    m.add_item( start_pos + point_east, item( pot ) );
+    u.mod_moves( -1 );
+    CHECK( u.crafting_inventory().has_amount( pot, 1 ) );
+
+    // Nothing changed on the map, but the character's own items still count.
+    u.i_add( item( pan ) );
+    u.mod_moves( -1 );
+    CHECK( u.crafting_inventory().has_amount( pot, 1 ) );
+    CHECK( u.crafting_inventory().has_amount( pan, 1 ) );
+
+    m.i_clear( start_pos + point_east );
+    u.mod_moves( -1 );
+    CHECK_FALSE( u.crafting_inventory().has_amount( pot, 1 ) );
+    CHECK( u.crafting_inventory().has_amount( pan, 1 ) );
+}
+
+TEST_CASE( "crafting_inventory_follows_vehicle_battery", "[crafting]" )
+{
+    map &m = get_map();
+    avatar &u = get_avatar();
+    const tripoint start_pos( 60, 60, 0 );
+    u.setpos( start_pos );
+    clear_avatar();
+    clear_map();
+    vehicle *veh = m.add_vehicle( vproto_id( "reactor_test" ), start_pos + point( 2, 1 ), 0_degrees,
+                                  0, 0 );
+    REQUIRE( veh != nullptr );
+    REQUIRE( veh->install_part( point_north, vpart_id( "kitchen_unit" ), true ) >= 0 );
+    veh->charge_battery( veh->fuel_capacity( itype_id( "battery" ) ), false );
+    const itype_id hotplate( "hotplate" );
+    u.invalidate_crafting_inventory();
+    const int full = u.crafting_inventory().charges_of( hotplate );
+    REQUIRE( full > 1 );
+
+    // Same turn, the map part of the inventory is reused unless the drain is noticed.
+    veh->discharge_battery( full / 2, false );
+    u.mod_moves( -1 );
+    CHECK( u.crafting_inventory().charges_of( hotplate ) == full - full / 2 );
+}
+
 TEST_CASE( "tool selection ui", "[crafting][ui]" )
 {
     npc dummy;
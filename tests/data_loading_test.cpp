@@ -0,0 +1,31 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+
+#include "game.h"
+#include "init.h"
+#include "loading_ui.h"
+#include "map_helpers.h"
+#include "string_formatter.h"
+
+// Reloads the core data and the mods the tests run with (see --mods), reporting how long
+// each phase took. Run with e.g. `tests/cata_test --mods=aftershock "[data_loading]"`.
+TEST_CASE( "data_loading_benchmark", "[.][data_loading][benchmark]" )
+{
+    // Monsters point into the data that is about to be replaced.
+    clear_map();
+
+    const auto start = std::chrono::steady_clock::now();
+    loading_ui ui( false );
+    g->load_core_data( ui );
+    g->load_world_modfiles( ui );
+    const std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+
+    const DynamicDataLoader::phase_times &times = DynamicDataLoader::get_instance().get_phase_times();
+    cata_printf( "reading:    %.3f s\n", times.reading );
+    cata_printf( "loading:    %.3f s\n", times.loading );
+    cata_printf( "finalizing: %.3f s\n", times.finalizing );
+    cata_printf( "checking:   %.3f s\n", times.checking );
+    cata_printf( "total:      %.3f s\n", total.count() );
+    CHECK( DynamicDataLoader::get_instance().is_data_finalized() );
+}
@@ -1,5 +1,6 @@
 #include "catch/catch.hpp"
 
+#include <memory>
 #include <vector>
 
 #include "active_tile_data.h"
@@ -434,3 +435,38 @@ TEST_CASE( "grid_furn_transform_queue_outside_bubble", "[grids]" )
     REQUIRE( sm->get_furn( pos_in_sm.raw() ).id() == f_floor_lamp_on );
     REQUIRE( active_tiles::furn_at<steady_consumer_tile>( pos_abs ) != nullptr );
 }
+
+TEST_CASE( "grid_battery_totals_follow_the_battery", "[grids]" )
+{
+    calendar::turn = calendar::turn_zero;
+    clear_map_and_put_player_underground();
+
+    grid_setup_watcher setup = set_up_grid_with_consumer<charge_watcher_tile, grid_setup_watcher>
+                               ( get_map(), f_floor_lamp );
+    distribution_grid &grid = setup.grid;
+    battery_tile &battery = setup.battery;
+    REQUIRE( battery.max_stored > 20 );
+    REQUIRE( grid.get_resource() == battery.get_resource() );
+
+    CHECK( grid.mod_resource( 10 ) == 0 );
+    CHECK( grid.get_resource( false ) == battery.get_resource() );
+    CHECK( grid.mod_resource( battery.max_stored ) == 10 );
+    CHECK( battery.get_resource() == battery.max_stored );
+    CHECK( grid.get_resource( false ) == battery.max_stored );
+    // Full already, nothing changes
+    CHECK( grid.mod_resource( 5 ) == 5 );
+    CHECK( grid.get_resource() == battery.max_stored );
+
+    // Changed without going through the grid
+    battery.mod_resource( -20 );
+    CHECK( grid.get_resource( false ) == battery.max_stored - 20 );
+    CHECK( grid.mod_resource( -( battery.max_stored + 7 ) ) == -27 );
+    CHECK( battery.get_resource() == 0 );
+    CHECK( grid.get_resource() == 0 );
+    CHECK( grid.mod_resource( -3 ) == -3 );
+
+    // A copy of the battery is not part of the grid
+    std::unique_ptr<active_tile_data> copy( battery.clone() );
+    static_cast<battery_tile &>( *copy ).mod_resource( 5 );
+    CHECK( grid.get_resource( false ) == 0 );
+}
@@ -1,6 +1,7 @@
 #include "catch/catch.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <sstream>
@@ -19,6 +20,7 @@
 #include "map_helpers.h"
 #include "monster.h"
 #include "point.h"
+#include "string_formatter.h"
 #include "string_id.h"
 #include "test_statistics.h"
 #include "type_id.h"
@@ -272,3 +274,39 @@ TEST_CASE( "rotated_vehicle_walls_block_explosions" )
     CHECK( m == &s );
     CHECK( m->get_hp() == m->get_hp_max() );
 }
+
+// Queues the explosions of 100 grenades in a 10x10 grid around origin.
+static void queue_grenades( const tripoint &origin )
+{
+    explosion_handler::get_explosion_queue().clear();
+    for( int i = 0; i < 100; ++i ) {
+        item grenade( "grenade_act" );
+        grenade.charges = 0;
+        grenade.type->invoke( g->u, grenade, origin + point( i % 10 * 4 - 18, i / 10 * 4 - 18 ) );
+    }
+}
+
+TEST_CASE( "grenades_going_off_together", "[grenade],[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    const tripoint origin( 60, 60, 0 );
+    const monster &zombie = spawn_test_monster( "mon_zombie", origin );
+    const monster &far_zombie = spawn_test_monster( "mon_zombie", origin + point( 40, 0 ) );
+
+    queue_grenades( origin );
+    explosion_handler::get_explosion_queue().execute();
+
+    CHECK( zombie.is_dead_state() );
+    CHECK( far_zombie.get_hp() == far_zombie.get_hp_max() );
+}
+
+TEST_CASE( "explosion_batch_benchmark", "[.][explosion][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    queue_grenades( tripoint( 60, 60, 0 ) );
+
+    const auto start = std::chrono::steady_clock::now();
+    explosion_handler::get_explosion_queue().execute();
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    cata_printf( "100 grenades: %.3f s\n", took.count() );
+}
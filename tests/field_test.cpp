@@ -0,0 +1,160 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "calendar.h"
+#include "field.h"
+#include "field_type.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+
+static std::vector<field_type_id> types_in( const field &fld )
+{
+    std::vector<field_type_id> result;
+    for( const field::entry &e : fld ) {
+        result.push_back( e.first );
+    }
+    return result;
+}
+
+TEST_CASE( "field_keeps_one_sorted_entry_per_type", "[field]" )
+{
+    field fld;
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.find_field( fd_fire ) == nullptr );
+
+    CHECK( fld.add_field( fd_smoke, 1 ) );
+    CHECK( fld.add_field( fd_fire, 2 ) );
+    CHECK( fld.add_field( fd_blood, 1 ) );
+    CHECK_FALSE( fld.add_field( fd_fire, 1 ) );
+    CHECK( fld.field_count() == 3 );
+    REQUIRE( fld.find_field( fd_fire ) != nullptr );
+    CHECK( fld.find_field( fd_fire )->get_field_intensity() == 3 );
+
+    const std::vector<field_type_id> types = types_in( fld );
+    CHECK( std::is_sorted( types.begin(), types.end() ) );
+
+    CHECK( fld.remove_field( fd_smoke ) );
+    CHECK_FALSE( fld.remove_field( fd_smoke ) );
+    CHECK( fld.field_count() == 2 );
+    CHECK( fld.find_field( fd_smoke ) == nullptr );
+}
+
+TEST_CASE( "pinned_field_keeps_its_entries_in_place", "[field]" )
+{
+    field fld;
+    fld.add_field( fd_fire, 1 );
+    fld.add_field( fd_smoke, 1 );
+    {
+        const field::pin pinned( fld );
+        field_entry *const fire = fld.find_field( fd_fire );
+        REQUIRE( fire != nullptr );
+        const field::const_iterator first = fld.begin();
+
+        CHECK( fld.add_field( fd_blood, 1 ) );
+        CHECK( fld.remove_field( fd_smoke ) );
+        // Nothing moved, the new field is found but not iterated yet.
+        CHECK( fld.find_field( fd_fire ) == fire );
+        CHECK( fld.begin() == first );
+        REQUIRE( fld.find_field( fd_blood ) != nullptr );
+        CHECK( fld.find_field( fd_smoke ) == nullptr );
+        CHECK( fld.field_count() == 2 );
+        CHECK( types_in( fld ).size() == 2 );
+
+        // Re-adding a removed field reuses its place.
+        CHECK( fld.add_field( fd_smoke, 2 ) );
+        CHECK( fld.find_field( fd_smoke )->get_field_intensity() == 2 );
+        CHECK( fld.remove_field( fd_smoke ) );
+    }
+    const std::vector<field_type_id> types = types_in( fld );
+    CHECK( types.size() == 2 );
+    CHECK( std::is_sorted( types.begin(), types.end() ) );
+    CHECK( fld.field_count() == 2 );
+    CHECK( fld.find_field( fd_blood ) != nullptr );
+    CHECK( fld.find_field( fd_smoke ) == nullptr );
+}
+
+TEST_CASE( "snapshot_gas_spread_is_repeatable", "[field]" )
+{
+    override_option snapshot( "SNAPSHOT_GAS_SPREAD", "true" );
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    const time_point start = calendar::turn;
+
+    // The gas of one turn, starting from a single tile.
+    const auto spread_once = [&]( const time_point & turn ) {
+        clear_map_and_put_player_underground();
+        calendar::turn = turn;
+        rng_set_engine_seed( 4242424242 );
+        here.add_field( center, fd_toxic_gas, 3 );
+        here.process_fields();
+        std::map<tripoint, int> result;
+        for( const tripoint &p : here.points_in_radius( center, 2 ) ) {
+            if( const field_entry *fe = here.get_field( p, fd_toxic_gas ) ) {
+                result[p] = fe->get_field_intensity();
+            }
+        }
+        return result;
+    };
+
+    bool spread = false;
+    for( int attempt = 0; attempt < 50 && !spread; ++attempt ) {
+        const time_point turn = start + time_duration::from_turns( attempt );
+        const std::map<tripoint, int> gas = spread_once( turn );
+        CHECK( spread_once( turn ) == gas );
+        spread = gas.size() > 1;
+    }
+    CHECK( spread );
+    calendar::turn = start;
+    clear_map();
+}
+
+TEST_CASE( "gas_spreads_onto_empty_tiles_as_fast_as_onto_others", "[field]" )
+{
+    override_option snapshot( "SNAPSHOT_GAS_SPREAD", "false" );
+    map &here = get_map();
+    // Not on a submap border, all neighbours are processed along with it
+    const tripoint center( SEEX * 5 + 6, SEEY * 5 + 6, 0 );
+    const time_point start = calendar::turn;
+
+    // The gas of one turn, with or without webs, which do nothing, on the tiles around it.
+    const auto spread_once = [&]( const time_point & turn, const bool webs ) {
+        clear_map_and_put_player_underground();
+        calendar::turn = turn;
+        if( webs ) {
+            for( const tripoint &p : here.points_in_radius( center, 1 ) ) {
+                here.add_field( p, fd_web, 1 );
+            }
+        }
+        here.add_field( center, fd_toxic_gas, 3, 10_turns );
+        rng_set_engine_seed( 4242424242 );
+        here.process_fields();
+        std::map<tripoint, std::pair<int, int>> result;
+        for( const tripoint &p : here.points_in_radius( center, 2 ) ) {
+            if( const field_entry *fe = here.get_field( p, fd_toxic_gas ) ) {
+                result[p] = std::make_pair( fe->get_field_intensity(),
+                                            to_turns<int>( fe->get_field_age() ) );
+            }
+        }
+        return result;
+    };
+
+    // Gas that spread to a tile visited after the center got processed the same turn.
+    bool spread_ahead = false;
+    for( int attempt = 0; attempt < 50 && !spread_ahead; ++attempt ) {
+        const time_point turn = start + time_duration::from_turns( attempt );
+        const std::map<tripoint, std::pair<int, int>> gas = spread_once( turn, false );
+        CHECK( spread_once( turn, true ) == gas );
+        spread_ahead = gas.upper_bound( center ) != gas.end();
+    }
+    CHECK( spread_ahead );
+    calendar::turn = start;
+    clear_map();
+}
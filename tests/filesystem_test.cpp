@@ -2,6 +2,7 @@
 
 #include <sstream>
 
+#include "background_save.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
 #include "string_formatter.h"
@@ -180,3 +181,41 @@ TEST_CASE( "filesystem_utf8_decomp", "[filesystem]" )
     // French (should stay decomposed)
     filesystem_test_group( 7, "cre\u0300me bru\u0302le\u0301e", "re\u0300m", "ru\u0302le\u0301" );
 }
+
+TEST_CASE( "background_save_writes_and_removes_files", "[filesystem]" )
+{
+    const std::string base = g->get_world_base_save_path() + "/fs_test_" + get_pid_string() +
+                             "_background/";
+    REQUIRE( !dir_exist( base ) );
+    REQUIRE( assure_dir_exist( base ) );
+    const std::string written = base + "written.json";
+    const std::string removed = base + "removed.json";
+    REQUIRE( write_to_file( removed, []( std::ostream & s ) {
+        s << "old";
+    }, nullptr ) );
+
+    {
+        background_save::batch batch;
+        REQUIRE( background_save::collecting() );
+        REQUIRE( write_to_file( written, []( std::ostream & s ) {
+            s << "new";
+        }, nullptr ) );
+        background_save::remove( removed );
+        // Nothing touches the disk before the batch is handed to the worker.
+        CHECK( !file_exist( written ) );
+        CHECK( file_exist( removed ) );
+    }
+    CHECK( !background_save::collecting() );
+
+    // Reading waits for the worker.
+    std::string readbuf;
+    REQUIRE( read_from_file( written, [&readbuf]( std::istream & s ) {
+        s >> readbuf;
+    } ) );
+    CHECK( readbuf == "new" );
+    background_save::wait();
+    CHECK( !file_exist( removed ) );
+
+    REQUIRE( remove_file( written ) );
+    REQUIRE( remove_directory( base ) );
+}
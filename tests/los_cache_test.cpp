@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+
+#include "los_cache.h"
+#include "point.h"
+
+TEST_CASE( "los_cache_stores_results_for_both_directions", "[vision]" )
+{
+    los_cache cache;
+    const tripoint a( 5, 10, 0 );
+    const tripoint b( 100, 3, -1 );
+    const tripoint c( 7, 7, 2 );
+
+    CHECK( cache.get( a, b ) == -1 );
+    cache.insert( a, b, true );
+    cache.insert( c, a, false );
+    CHECK( cache.get( a, b ) == 1 );
+    CHECK( cache.get( b, a ) == 1 );
+    CHECK( cache.get( a, c ) == 0 );
+    CHECK( cache.get( c, a ) == 0 );
+    CHECK( cache.get( b, c ) == -1 );
+    CHECK( cache.size() == 2 );
+
+    // Overwriting doesn't take another slot
+    cache.insert( b, a, false );
+    CHECK( cache.get( a, b ) == 0 );
+    CHECK( cache.size() == 2 );
+
+    cache.clear();
+    CHECK( cache.size() == 0 );
+    CHECK( cache.get( a, b ) == -1 );
+    CHECK( cache.get( c, a ) == -1 );
+}
+
+TEST_CASE( "los_cache_clears_itself_when_full", "[vision]" )
+{
+    los_cache cache;
+    int inserted = 0;
+    for( int x = 0; x < 132 && inserted < los_cache::max_size; x++ ) {
+        for( int y = 0; y < 132 && inserted < los_cache::max_size; y++ ) {
+            for( int z = -2; z <= 2 && inserted < los_cache::max_size; z++ ) {
+                cache.insert( tripoint( x, y, z ), tripoint_zero, ( x + y ) % 2 == 0 );
+                inserted++;
+            }
+        }
+    }
+    CHECK( cache.size() == los_cache::max_size );
+    CHECK( cache.get( tripoint( 1, 1, 0 ), tripoint_zero ) == 1 );
+    CHECK( cache.get( tripoint( 1, 2, 0 ), tripoint_zero ) == 0 );
+
+    cache.insert( tripoint( 1, 2, 3 ), tripoint( 4, 5, 6 ), true );
+    CHECK( cache.size() == 1 );
+    CHECK( cache.get( tripoint( 1, 1, 0 ), tripoint_zero ) == -1 );
+    CHECK( cache.get( tripoint( 1, 2, 3 ), tripoint( 4, 5, 6 ) ) == 1 );
+}
+
+TEST_CASE( "los_cache_benchmark", "[.][vision][benchmark]" )
+{
+    los_cache cache;
+    // Roughly what a turn of monster vision checks against a few targets looks like
+    BENCHMARK( "insert and query 10000 pairs" ) {
+        int seen = 0;
+        for( int i = 0; i < 10000; i++ ) {
+            const tripoint from( i % 132, i / 132, 0 );
+            const tripoint to( 60 + i % 3, 60, 0 );
+            if( cache.get( from, to ) < 0 ) {
+                cache.insert( from, to, i % 7 != 0 );
+            }
+            seen += cache.get( to, from );
+        }
+        cache.clear();
+        return seen;
+    };
+}
@@ -42,7 +42,7 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
     memory.prepare_region( p1, p2 );
     CHECK( memory.get_symbol( p1 ) == 0 );
     memorized_terrain_tile default_tile = memory.get_tile( p1 );
-    CHECK( default_tile.tile.empty() );
+    CHECK( default_tile.tile().empty() );
     CHECK( default_tile.subtile == 0 );
     CHECK( default_tile.rotation == 0 );
 }
@@ -75,7 +75,84 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+TEST_CASE( "memorized_tiles_share_interned_names", "[map_memory]" )
+{
+    const memorized_terrain_tile wall( "t_wall", 1, 2 );
+    const memorized_terrain_tile other_wall( "t_wall", 3, 0 );
+    CHECK( wall.tile_id == other_wall.tile_id );
+    CHECK( wall.tile() == "t_wall" );
+    CHECK( memorized_terrain_tile( "t_floor", 1, 2 ) != wall );
+    CHECK( memorized_terrain_tile( "", 0, 0 ) == mm_submap::default_tile );
+}
+
+static mm_region make_test_region()
+{
+    mm_region region;
+    for( auto &column : region.submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
+            sm = make_shared_fast<mm_submap>();
+        }
+    }
+    mm_submap &first = *region.submaps[0][0];
+    for( int x = 0; x < SEEX; ++x ) {
+        first.set_tile( point( x, 3 ), memorized_terrain_tile( "t_wall", 1, x % 4 ) );
+    }
+    first.set_tile( point( 5, 5 ), memorized_terrain_tile( "f_chair", 0, 0 ) );
+    first.set_symbol( point( 5, 5 ), '#' );
+    region.submaps[1][MM_REG_SIZE - 1]->set_tile( point( 2, 1 ),
+            memorized_terrain_tile( "t_wall", 0, 0 ) );
+    return region;
+}
+
+static void check_same_region( const mm_region &a, const mm_region &b )
+{
+    for( size_t x = 0; x < MM_REG_SIZE; ++x ) {
+        for( size_t y = 0; y < MM_REG_SIZE; ++y ) {
+            CAPTURE( x, y );
+            REQUIRE( b.submaps[x][y] );
+            CHECK( a.submaps[x][y]->is_empty() == b.submaps[x][y]->is_empty() );
+            for( const point &p : { point( 0, 3 ), point( 3, 3 ), point( 5, 5 ), point( 2, 1 ) } ) {
+                CHECK( a.submaps[x][y]->tile( p ) == b.submaps[x][y]->tile( p ) );
+                CHECK( a.submaps[x][y]->symbol( p ) == b.submaps[x][y]->symbol( p ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    const mm_region region = make_test_region();
+    std::ostringstream os;
+    JsonOut jsout( os );
+    region.serialize( jsout );
+    const std::string json = os.str();
+    // Each name is written once per region
+    CHECK( json.find( "t_wall" ) == json.rfind( "t_wall" ) );
+
+    std::istringstream is( json );
+    JsonIn jsin( is );
+    mm_region loaded;
+    loaded.deserialize( jsin );
+    check_same_region( region, loaded );
+}
+
+TEST_CASE( "map_memory_reads_legacy_regions", "[map_memory]" )
+{
+    // A region in the format with the tile names written out for each run
+    std::string json = "[";
+    for( size_t i = 0; i < MM_REG_SIZE * MM_REG_SIZE; ++i ) {
+        json += i == 0 ? R"([["",0,0,0,3],["t_wall",1,2,35],["",0,0,0,140]])" : ",null";
+    }
+    json += "]";
+    std::istringstream is( json );
+    JsonIn jsin( is );
+    mm_region loaded;
+    loaded.deserialize( jsin );
+    CHECK( loaded.submaps[0][0]->tile( point( 3, 0 ) ) == memorized_terrain_tile( "t_wall", 1, 2 ) );
+    CHECK( loaded.submaps[0][0]->symbol( point( 3, 0 ) ) == 35 );
+    CHECK( loaded.submaps[0][0]->tile( point( 4, 0 ) ) == mm_submap::default_tile );
+    CHECK( loaded.submaps[1][0]->is_empty() );
+}
 
 #include <chrono>
 
@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "avatar.h"
+#include "creature_tracker.h"
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -347,3 +348,28 @@ TEST_CASE( "monster_move_through_vehicle_holes" )
     CHECK( m2 == nullptr );
 
 }
+
+TEST_CASE( "monsters_within_tracks_moving_monsters", "[monster]" )
+{
+    clear_map_and_put_player_underground();
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const tripoint origin( 60, 60, 0 );
+
+    monster &near = spawn_test_monster( "mon_zombie", origin + tripoint( 3, -3, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", origin + tripoint( 20, 0, 0 ) );
+
+    std::vector<monster *> found = tracker.monsters_within( origin, 5 );
+    REQUIRE( found.size() == 1 );
+    CHECK( found.front() == &near );
+    CHECK( tracker.monsters_within( origin, 20 ).size() == 2 );
+    CHECK( tracker.monsters_within( origin, 20, []( const monster & mon ) {
+        return mon.pos().x > 70;
+    } ).size() == 1 );
+
+    // Moving across a cell boundary must move it between buckets too.
+    far.setpos( origin + tripoint( 4, 0, 0 ) );
+    CHECK( tracker.monsters_within( origin, 5 ).size() == 2 );
+
+    far.die( nullptr );
+    CHECK( tracker.monsters_within( origin, 5 ).size() == 1 );
+}
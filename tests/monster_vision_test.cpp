@@ -1,16 +1,19 @@
 #include "catch/catch.hpp"
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "cached_options.h"
 #include "calendar.h"
 #include "game.h"
+#include "line.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "mapdata.h"
 #include "monster.h"
 #include "options_helpers.h"
-
-struct tripoint;
+#include "point.h"
 
 static monster &spawn_and_clear( const tripoint &pos, bool set_floor )
 {
@@ -100,3 +103,108 @@ TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
     CHECK( !outside.sees( inside ) );
 
 }
+
+// A few walls to look around, and some monsters scattered among them
+static std::vector<monster *> spawn_vision_crowd( const int count )
+{
+    calendar::turn = midday;
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    for( int x = 10; x < MAPSIZE_X - 10; x += 12 ) {
+        for( int y = 20; y < MAPSIZE_Y - 20; y++ ) {
+            here.ter_set( tripoint( x, y, 0 ), t_wall );
+        }
+    }
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0 );
+
+    std::vector<monster *> crowd;
+    for( int i = 0; static_cast<int>( crowd.size() ) < count; i++ ) {
+        const tripoint p( 30 + ( i * 7 ) % 72, 30 + ( i * 13 ) % 72, 0 );
+        if( here.passable( p ) && g->critter_at( p ) == nullptr ) {
+            crowd.push_back( &spawn_test_monster( "mon_zombie", p ) );
+        }
+    }
+    return crowd;
+}
+
+TEST_CASE( "monsters_see_the_same_with_fov_bitmaps", "[vision]" )
+{
+    const bool old_fov_bitmaps = monster_fov_bitmaps;
+    std::vector<monster *> crowd = spawn_vision_crowd( 20 );
+    monster &left = *crowd[0];
+    monster &right = spawn_test_monster( "mon_zombie", left.pos() + tripoint( 6, 0, 0 ) );
+    monster &walled = spawn_test_monster( "mon_zombie", left.pos() + tripoint( 0, 6, 0 ) );
+    map &here = get_map();
+    for( int x = -1; x <= 1; x++ ) {
+        here.ter_set( walled.pos() + tripoint( x, -1, 0 ), t_wall );
+    }
+    here.build_map_cache( 0 );
+
+    monster_fov_bitmaps = true;
+    CHECK( left.sees( right ) );
+    CHECK( right.sees( left ) );
+    CHECK( !left.sees( walled ) );
+    CHECK( !walled.sees( left ) );
+
+    SECTION( "changes to the map are noticed" ) {
+        for( int x = -1; x <= 1; x++ ) {
+            here.ter_set( walled.pos() + tripoint( x, -1, 0 ), t_floor );
+        }
+        here.ter_set( left.pos() + tripoint( 3, 0, 0 ), t_wall );
+        here.build_map_cache( 0 );
+        CHECK( left.sees( walled ) );
+        CHECK( walled.sees( left ) );
+        CHECK( !left.sees( right ) );
+        CHECK( !right.sees( left ) );
+    }
+
+    SECTION( "open lines of sight agree with the line checks" ) {
+        // Targets with a clear straight line to them are seen either way
+        for( monster *observer : crowd ) {
+            for( monster *target : crowd ) {
+                monster_fov_bitmaps = false;
+                const bool line = observer->sees( *target );
+                monster_fov_bitmaps = true;
+                if( line && rl_dist( observer->pos(), target->pos() ) > 1 ) {
+                    CHECK( observer->sees( *target ) );
+                }
+            }
+        }
+    }
+    monster_fov_bitmaps = old_fov_bitmaps;
+}
+
+static void benchmark_vision( const int count )
+{
+    const bool old_fov_bitmaps = monster_fov_bitmaps;
+    const std::vector<monster *> crowd = spawn_vision_crowd( count );
+    // Every monster looking at every other, like monster::plan does for its friends
+    const auto look_around = [&crowd]() {
+        calendar::turn += 1_turns;
+        int seen = 0;
+        for( const monster *observer : crowd ) {
+            for( const monster *target : crowd ) {
+                seen += observer->sees( *target );
+            }
+        }
+        return seen;
+    };
+
+    monster_fov_bitmaps = false;
+    BENCHMARK( "line checks, " + std::to_string( count ) + " monsters" ) {
+        return look_around();
+    };
+    monster_fov_bitmaps = true;
+    BENCHMARK( "fov bitmaps, " + std::to_string( count ) + " monsters" ) {
+        return look_around();
+    };
+    monster_fov_bitmaps = old_fov_bitmaps;
+}
+
+TEST_CASE( "monster_vision_benchmark", "[.][vision][benchmark]" )
+{
+    benchmark_vision( 20 );
+    benchmark_vision( 100 );
+    benchmark_vision( 300 );
+}
@@ -0,0 +1,257 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "game.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "pathfinding.h"
+#include "point.h"
+
+static const pathfinding_settings test_settings( 0, 1000, 1000, 0, false, false, true, false,
+        false );
+
+// Walls every 6 columns, each with a door-sized gap every 8 rows, shifted between walls
+// so routes have to weave across the whole map
+static void build_cluttered_map()
+{
+    clear_map();
+    map &here = get_map();
+    for( int x = 6; x < MAPSIZE_X - 6; x += 6 ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( ( y / 8 + x / 6 ) % 3 != 0 ) {
+                here.ter_set( tripoint( x, y, 0 ), t_wall );
+            }
+        }
+    }
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+}
+
+static void check_route( const std::vector<tripoint> &route, const tripoint &from,
+                         const tripoint &to )
+{
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        CHECK( rl_dist( prev, p ) == 1 );
+        CHECK( get_map().passable( p ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "route_goes_around_walls", "[pathfinding]" )
+{
+    build_cluttered_map();
+    map &here = get_map();
+    const tripoint from( 3, 3, 0 );
+    const tripoint to( MAPSIZE_X - 3, MAPSIZE_Y - 3, 0 );
+
+    const std::vector<tripoint> route = here.route( from, to, test_settings );
+    check_route( route, from, to );
+
+    SECTION( "repeated searches don't see each other's state" ) {
+        // A failed search in between must not leave anything behind either
+        here.ter_set( tripoint( 1, 1, 0 ), t_wall );
+        CHECK( here.route( from, tripoint( 1, 1, 0 ), test_settings ).empty() );
+        here.ter_set( tripoint( 1, 1, 0 ), t_grass );
+
+        for( int i = 0; i < 3; i++ ) {
+            CHECK( here.route( from, to, test_settings ) == route );
+            CHECK( here.route( to, from, test_settings ).size() == route.size() );
+        }
+    }
+
+    SECTION( "pre-closed tiles are avoided" ) {
+        const std::set<tripoint> avoid( route.begin(), route.end() - 1 );
+        const std::vector<tripoint> detour = here.route( from, to, test_settings, avoid );
+        check_route( detour, from, to );
+        for( const tripoint &p : detour ) {
+            CHECK( ( p == to || avoid.count( p ) == 0 ) );
+        }
+        // And forgotten by the next search
+        CHECK( here.route( from, to, test_settings ) == route );
+    }
+}
+
+TEST_CASE( "route_finds_detours_far_from_the_endpoints", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // A wall across the whole map, with a single gap far from both endpoints
+    const int wall_x = MAPSIZE_X / 2;
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        here.ter_set( tripoint( wall_x, y, 0 ), t_wall );
+    }
+    here.ter_set( tripoint( wall_x, MAPSIZE_Y - 3, 0 ), t_grass );
+    const tripoint from( wall_x - 10, 10, 0 );
+    const tripoint to( wall_x + 10, 10, 0 );
+
+    const std::vector<tripoint> route = here.route( from, to, test_settings );
+    check_route( route, from, to );
+    CHECK( std::find( route.begin(), route.end(), tripoint( wall_x, MAPSIZE_Y - 3, 0 ) ) !=
+           route.end() );
+
+    SECTION( "closing the gap is noticed" ) {
+        here.ter_set( tripoint( wall_x, MAPSIZE_Y - 3, 0 ), t_wall );
+        CHECK( here.route( from, to, test_settings ).empty() );
+
+        here.ter_set( tripoint( wall_x, 2, 0 ), t_grass );
+        const std::vector<tripoint> new_route = here.route( from, to, test_settings );
+        check_route( new_route, from, to );
+        CHECK( std::find( new_route.begin(), new_route.end(), tripoint( wall_x, 2, 0 ) ) !=
+               new_route.end() );
+    }
+}
+
+TEST_CASE( "route_steps_diagonally_across_submap_borders", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // Walls on both sides of a submap border, with gaps that only touch diagonally
+    const int wall_x = SEEX * 5;
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        if( y != 10 ) {
+            here.ter_set( tripoint( wall_x - 1, y, 0 ), t_wall );
+        }
+        if( y != 11 ) {
+            here.ter_set( tripoint( wall_x, y, 0 ), t_wall );
+        }
+    }
+    const tripoint from( wall_x - 10, 30, 0 );
+    const tripoint to( wall_x + 10, 30, 0 );
+
+    const std::vector<tripoint> route = here.route( from, to, test_settings );
+    check_route( route, from, to );
+    CHECK( std::find( route.begin(), route.end(), tripoint( wall_x, 11, 0 ) ) != route.end() );
+}
+
+TEST_CASE( "shared_routes_follow_the_map", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    const int wall_x = MAPSIZE_X / 2;
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        here.ter_set( tripoint( wall_x, y, 0 ), t_wall );
+    }
+    here.ter_set( tripoint( wall_x, 20, 0 ), t_grass );
+    const tripoint target( wall_x + 10, 10, 0 );
+    const std::vector<tripoint> starts = {
+        { wall_x - 10, 5, 0 }, { wall_x - 20, 30, 0 }, { wall_x - 5, 50, 0 }
+    };
+    const std::vector<monster> requesters( starts.size() );
+
+    // The first caller gets a plain route, the others share a distance field
+    for( int pass = 0; pass < 2; pass++ ) {
+        for( size_t i = 0; i < starts.size(); i++ ) {
+            const tripoint &start = starts[i];
+            const std::vector<tripoint> shared = here.route_shared( start, target, test_settings,
+                                                 &requesters[i] );
+            check_route( shared, start, target );
+            CHECK( std::find( shared.begin(), shared.end(), tripoint( wall_x, 20, 0 ) ) != shared.end() );
+        }
+    }
+
+    // Moving the gap invalidates the field
+    here.ter_set( tripoint( wall_x, 20, 0 ), t_wall );
+    here.ter_set( tripoint( wall_x, 60, 0 ), t_grass );
+    for( size_t i = 0; i < starts.size(); i++ ) {
+        const tripoint &start = starts[i];
+        const std::vector<tripoint> shared = here.route_shared( start, target, test_settings,
+                                             &requesters[i] );
+        check_route( shared, start, target );
+        CHECK( std::find( shared.begin(), shared.end(), tripoint( wall_x, 60, 0 ) ) != shared.end() );
+    }
+}
+
+TEST_CASE( "lone_creature_never_builds_a_flow_field", "[pathfinding]" )
+{
+    build_cluttered_map();
+    map &here = get_map();
+    const tripoint target( MAPSIZE_X - 3, MAPSIZE_Y / 2, 0 );
+    const monster zombie;
+    const monster other_zombie;
+
+    // Asking turn after turn while walking up to the target
+    for( int x = 2; x < 20; x++ ) {
+        const tripoint from( x, MAPSIZE_Y / 2, 0 );
+        if( !here.passable( from ) ) {
+            continue;
+        }
+        CHECK( here.get_flow_field( target, test_settings, &zombie ) == nullptr );
+        check_route( here.route_shared( from, target, test_settings, &zombie ), from, target );
+    }
+    CHECK( here.get_flow_field( target, test_settings, &other_zombie ) != nullptr );
+
+    // A map change makes the requesters count again
+    here.ter_set( tripoint( 6, 0, 0 ), t_grass );
+    CHECK( here.get_flow_field( target, test_settings, &other_zombie ) == nullptr );
+    CHECK( here.get_flow_field( target, test_settings, &other_zombie ) == nullptr );
+    CHECK( here.get_flow_field( target, test_settings, &zombie ) != nullptr );
+}
+
+TEST_CASE( "route_500_monsters_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_cluttered_map();
+    const tripoint target = g->u.pos();
+    std::vector<tripoint> starts;
+    for( int i = 0; static_cast<int>( starts.size() ) < 500; i++ ) {
+        const tripoint p( ( i * 37 ) % MAPSIZE_X, ( i / MAPSIZE_X * 11 + i * 5 ) % MAPSIZE_Y, 0 );
+        if( get_map().passable( p ) && p != target ) {
+            starts.push_back( p );
+        }
+    }
+
+    BENCHMARK( "one turn of routes" ) {
+        size_t total = 0;
+        for( const tripoint &p : starts ) {
+            total += get_map().route( p, target, test_settings ).size();
+        }
+        return total;
+    };
+}
+
+static void benchmark_horde( const int count )
+{
+    const tripoint target = g->u.pos();
+    std::vector<tripoint> starts;
+    for( int i = 0; static_cast<int>( starts.size() ) < count; i++ ) {
+        const tripoint p( ( i * 37 ) % MAPSIZE_X, ( i / MAPSIZE_X * 11 + i * 5 ) % MAPSIZE_Y, 0 );
+        if( get_map().passable( p ) && p != target ) {
+            starts.push_back( p );
+        }
+    }
+
+    BENCHMARK( "individual routes, " + std::to_string( count ) + " zombies" ) {
+        size_t total = 0;
+        for( const tripoint &p : starts ) {
+            total += get_map().route( p, target, test_settings ).size();
+        }
+        return total;
+    };
+    const std::vector<monster> zombies( starts.size() );
+    BENCHMARK( "shared routes, " + std::to_string( count ) + " zombies" ) {
+        size_t total = 0;
+        for( size_t i = 0; i < starts.size(); i++ ) {
+            total += get_map().route_shared( starts[i], target, test_settings, &zombies[i] ).size();
+        }
+        return total;
+    };
+}
+
+TEST_CASE( "horde_routes_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_cluttered_map();
+    benchmark_horde( 50 );
+    benchmark_horde( 200 );
+    benchmark_horde( 500 );
+}
@@ -4,6 +4,9 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "game.h"
+#include "point.h"
+#include "type_id.h"
+
 void old_scent_map_update( const tripoint &center, map &m,
                            std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent );
 
@@ -169,3 +172,150 @@ TEST_CASE( "scent_matches_old", "[.]" )
     }
 }
 
+
+// The update as it was before it learned to skip the parts of the map without scent.
+static void full_window_scent_update( const tripoint &center, map &m,
+                                      std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X> scent_transfer;
+
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
+                              scent_transfer[abs.x][abs.y] ) ;
+            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
+                           ( 45 - squares_used ) / 5;
+
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+static void place_scent_obstacles( const tripoint &origin )
+{
+    map &here = get_map();
+    for( int i = -6; i <= 6; ++i ) {
+        here.ter_set( origin + tripoint( i, 4, 0 ), t_brick_wall );
+        here.ter_set( origin + tripoint( -5, i, 0 ), t_rock_wall_half );
+    }
+}
+
+TEST_CASE( "scent_update_matches_full_window_update", "[scent]" )
+{
+    clear_map();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    place_scent_obstacles( origin );
+    g->scent.reset();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> expected;
+    for( auto &elem : expected ) {
+        elem.fill( 0 );
+    }
+
+    // Scent near the edge of the update window, plus a trail that keeps growing.
+    const std::vector<tripoint> sources = {
+        origin, origin + tripoint( 38, -39, 0 ), origin + tripoint( -40, 40, 0 )
+    };
+    for( const tripoint &p : sources ) {
+        g->scent.set( p, 1000, scenttype_id( "sc_human" ) );
+        expected[p.x][p.y] = 1000;
+    }
+    for( int turn = 0; turn < 50; ++turn ) {
+        const tripoint trail = origin + tripoint( turn % 10, 2, 0 );
+        g->scent.set( trail, 500 );
+        expected[trail.x][trail.y] = 500;
+        g->scent.update( origin, here );
+        full_window_scent_update( origin, here, expected );
+    }
+
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            INFO( x );
+            INFO( y );
+            CHECK( expected[x][y] == g->scent.get( { x, y, 0 } ) );
+        }
+    }
+}
+
+TEST_CASE( "scent_update_benchmark", "[.][scent][benchmark]" )
+{
+    clear_map();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    place_scent_obstacles( origin );
+    g->scent.reset();
+    g->scent.set( origin, 1000, scenttype_id( "sc_human" ) );
+
+    BENCHMARK( "localized scent" ) {
+        g->scent.set( origin, 1000 );
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+
+    for( int x = origin.x - 40; x <= origin.x + 40; x += 4 ) {
+        for( int y = origin.y - 40; y <= origin.y + 40; y += 4 ) {
+            g->scent.set( { x, y, 0 }, 1000 );
+        }
+    }
+    BENCHMARK( "scent over the whole window" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+}
@@ -1,13 +1,16 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <functional>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "cached_options.h"
 #include "game_constants.h"
 #include "lightmap.h"
 #include "line.h" // For rl_dist.
@@ -77,6 +80,80 @@ static void oldCastLight( float ( &output_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY
     }
 }
 
+// castLight as it was before it reused the intensity along a row, computing it for every tile.
+// Ignores diagonal blocks.
+// NOLINTNEXTLINE(cata-xy)
+static void perTileCastLight( float ( &output_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY],
+                              const float ( &input_array )[MAPSIZE * SEEX][MAPSIZE * SEEY],
+                              const int xx, const int xy, const int yx, const int yy,
+                              const point &offset, const int row = 1, float start = 1.0f,
+                              const float end = 0.0f,
+                              float cumulative_transparency = LIGHT_TRANSPARENCY_OPEN_AIR )
+{
+    float newStart = 0.0f;
+    const float radius = 60.0f;
+    if( start < end ) {
+        return;
+    }
+    float last_intensity = 0.0f;
+    tripoint delta;
+    for( int distance = row; distance <= radius; distance++ ) {
+        delta.y = -distance;
+        bool started_row = false;
+        float current_transparency = 0.0f;
+        const float away = start - ( -distance + 0.5f ) / ( -distance - 0.5f );
+        delta.x = -distance + std::max( static_cast<int>( std::ceil( away * ( -distance - 0.5f ) ) ),
+                                        0 );
+        for( ; delta.x <= 0; delta.x++ ) {
+            const point current( offset.x + delta.x * xx + delta.y * xy,
+                                 offset.y + delta.x * yx + delta.y * yy );
+            const float trailingEdge = ( delta.x - 0.5f ) / ( delta.y + 0.5f );
+            const float leadingEdge = ( delta.x + 0.5f ) / ( delta.y - 0.5f );
+            if( !( current.x >= 0 && current.y >= 0 && current.x < MAPSIZE_X &&
+                   current.y < MAPSIZE_Y ) ) {
+                continue;
+            } else if( end > trailingEdge ) {
+                break;
+            }
+            if( !started_row ) {
+                started_row = true;
+                current_transparency = input_array[current.x][current.y];
+            }
+
+            last_intensity = sight_calc( VISIBILITY_FULL, cumulative_transparency,
+                                         rl_dist( tripoint_zero, delta ) );
+            const float new_transparency = input_array[current.x][current.y];
+            update_light( output_cache[current.x][current.y], last_intensity, quadrant::default_ );
+
+            if( new_transparency == current_transparency ) {
+                newStart = leadingEdge;
+                continue;
+            }
+            if( sight_check( current_transparency, last_intensity ) ) {
+                perTileCastLight( output_cache, input_array, xx, xy, yx, yy, offset, distance + 1,
+                                  start, trailingEdge,
+                                  accumulate_transparency( cumulative_transparency,
+                                          current_transparency, distance ) );
+            }
+            if( !sight_check( current_transparency, last_intensity ) ) {
+                start = newStart;
+            } else {
+                start = trailingEdge;
+            }
+            if( start < end ) {
+                return;
+            }
+            current_transparency = new_transparency;
+            newStart = leadingEdge;
+        }
+        if( !sight_check( current_transparency, last_intensity ) ) {
+            break;
+        }
+        cumulative_transparency = accumulate_transparency( cumulative_transparency,
+                                  current_transparency, distance );
+    }
+}
+
 /*
  * This is checking whether bresenham visibility checks match shadowcasting (they don't).
  */
@@ -346,6 +423,59 @@ static void shadowcasting_float_quad(
     REQUIRE( passed );
 }
 
+// Fills the map with open air, walls and a few kinds of smoke, so that the transparency
+// accumulated along the rows varies.
+static void fill_varying_transparency(
+    float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] )
+{
+    const std::array<float, 5> values = {{
+            LIGHT_TRANSPARENCY_SOLID, LIGHT_TRANSPARENCY_OPEN_AIR, LIGHT_TRANSPARENCY_OPEN_AIR * 2,
+            LIGHT_TRANSPARENCY_OPEN_AIR * 5, LIGHT_TRANSPARENCY_OPEN_AIR * 10
+        }
+    };
+    std::uniform_int_distribution<int> distribution( 0, 19 );
+    for( auto &inner : transparency_cache ) {
+        for( float &square : inner ) {
+            const int roll = distribution( rng_get_engine() );
+            square = roll < static_cast<int>( values.size() ) ? values[roll] :
+                     LIGHT_TRANSPARENCY_OPEN_AIR;
+        }
+    }
+}
+
+static void shadowcasting_per_tile_equivalence( const point &offset )
+{
+    float lit_squares_control[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    float lit_squares_experiment[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{{false, false}}};
+
+    fill_varying_transparency( transparency_cache );
+
+    castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+        lit_squares_experiment, transparency_cache, blocked_cache, offset );
+
+    // Same octant order as castLightAll.
+    const std::array<std::array<int, 4>, 8> octants = {{
+            {{ 0, 1, 1, 0 }}, {{ 1, 0, 0, 1 }}, {{ 0, -1, 1, 0 }}, {{ -1, 0, 0, 1 }},
+            {{ 0, 1, -1, 0 }}, {{ 1, 0, 0, -1 }}, {{ 0, -1, -1, 0 }}, {{ -1, 0, 0, -1 }}
+        }
+    };
+    for( const std::array<int, 4> &o : octants ) {
+        perTileCastLight( lit_squares_control, transparency_cache, o[0], o[1], o[2], o[3], offset );
+    }
+
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE * SEEX; ++x ) {
+        for( int y = 0; y < MAPSIZE * SEEY; ++y ) {
+            if( lit_squares_control[x][y] != lit_squares_experiment[x][y] ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
 static void shadowcasting_3d_2d( const int iterations )
 {
     float seen_squares_control[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
@@ -653,6 +783,45 @@ TEST_CASE( "shadowcasting_float_quad_performance", "[.]" )
     shadowcasting_float_quad( 1000000, 100 );
 }
 
+TEST_CASE( "shadowcasting_matches_per_tile_intensity", "[shadowcasting]" )
+{
+    const bool old_trigdist = trigdist;
+    for( const bool use_trigdist : {
+             false, true
+         } ) {
+        trigdist = use_trigdist;
+        CAPTURE( trigdist );
+        shadowcasting_per_tile_equivalence( point( 65, 65 ) );
+        shadowcasting_per_tile_equivalence( point( 3, 120 ) );
+    }
+    trigdist = old_trigdist;
+}
+
+TEST_CASE( "shadowcasting_many_lights_benchmark", "[.][shadowcasting][benchmark]" )
+{
+    static float lit_squares[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    std::uninitialized_fill_n( &blocked_cache[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY,
+                               diagonal_blocks{ false, false } );
+    fill_varying_transparency( transparency_cache );
+
+    std::vector<point> lights;
+    std::uniform_int_distribution<int> coordinate( 0, MAPSIZE * SEEX - 1 );
+    for( int i = 0; i < 1000; ++i ) {
+        lights.emplace_back( coordinate( rng_get_engine() ), coordinate( rng_get_engine() ) );
+    }
+
+    BENCHMARK( "cast 1000 lights" ) {
+        std::fill_n( &lit_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+        for( const point &p : lights ) {
+            castLightAll<float, float, sight_calc, sight_check, update_light,
+                         accumulate_transparency>( lit_squares, transparency_cache, blocked_cache, p );
+        }
+        return lit_squares[0][0];
+    };
+}
+
 // I'm not sure this will ever work.
 TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
@@ -0,0 +1,45 @@
+#include "catch/catch.hpp"
+
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "sounds.h"
+#include "weather.h"
+
+// Whether a zombie 8 tiles away from a bang of volume 12 hears it.
+static bool zombie_hears_bang( const bool walled_in, const bool propagate )
+{
+    override_option propagation( "SOUND_PROPAGATION", propagate ? "true" : "false" );
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    const tripoint source( 60, 60, 0 );
+    const tripoint listener_pos = source + point( 8, 0 );
+    if( walled_in ) {
+        for( const tripoint &p : here.points_in_radius( listener_pos, 2 ) ) {
+            if( square_dist( p, listener_pos ) == 2 ) {
+                here.ter_set( p, t_wall_metal );
+            }
+        }
+    }
+    monster &zombie = spawn_test_monster( "mon_zombie", listener_pos );
+    zombie.wandf = 0;
+
+    sounds::reset_sounds();
+    const int volume = 12 + get_weather().weather_id->sound_attn;
+    sounds::sound( source, volume, sounds::sound_t::combat, "bang" );
+    sounds::process_sounds();
+    return zombie.wandf > 0;
+}
+
+TEST_CASE( "propagated_sounds_are_muffled_by_walls", "[sounds]" )
+{
+    CHECK( zombie_hears_bang( false, false ) );
+    CHECK( zombie_hears_bang( true, false ) );
+    CHECK( zombie_hears_bang( false, true ) );
+    CHECK_FALSE( zombie_hears_bang( true, true ) );
+}
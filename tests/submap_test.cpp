@@ -1,9 +1,28 @@
 #include "catch/catch.hpp"
 
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "submap.h"
+#include "submap_binary.h"
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
 #include "point.h"
+#include "string_formatter.h"
+#include "trap.h"
 #include "type_id.h"
 
 TEST_CASE( "submap rotation", "[submap]" )
@@ -90,3 +109,159 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+static std::string stored_json( const submap &sm )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    sm.store( jsout );
+    jsout.end_object();
+    return os.str();
+}
+
+static std::unique_ptr<submap> json_round_trip( const submap &sm )
+{
+    std::istringstream is( stored_json( sm ) );
+    JsonIn jsin( is );
+    std::unique_ptr<submap> result = std::make_unique<submap>();
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string member_name = jsin.get_member_name();
+        result->load( jsin, member_name, savegame_version );
+    }
+    return result;
+}
+
+TEST_CASE( "submap binary round trip", "[submap]" )
+{
+    submap first;
+    submap second;
+    first.set_all_ter( t_floor );
+    second.set_all_ter( t_dirt );
+    first.set_ter( { 3, 4 }, t_rock_wall_half );
+    first.set_furn( { 5, 6 }, f_chair );
+    first.set_trap( { 7, 8 }, tr_bubblewrap );
+    second.set_radiation( { SEEX - 1, SEEY - 1 }, 42 );
+    first.get_field( { 1, 2 } ).add_field( field_type_id( "fd_blood" ), 2, 10_turns );
+    first.field_count = 1;
+    first.get_items( { 9, 10 } ).insert( item( "rock" ) );
+    first.set_graffiti( { 11, 0 }, "binary" );
+    first.set_temperature( 21 );
+
+    std::ostringstream os;
+    submap_binary::write_quad( os, {
+        { tripoint( 2, 4, 0 ), &first }, { tripoint( 2, 5, 0 ), &second }
+    } );
+    std::istringstream is( os.str() );
+    submap_binary::quad loaded = submap_binary::read_quad( is );
+
+    REQUIRE( loaded.size() == 2 );
+    CHECK( loaded[0].first == tripoint( 2, 4, 0 ) );
+    CHECK( loaded[1].first == tripoint( 2, 5, 0 ) );
+    const submap &first_loaded = *loaded[0].second;
+    const submap &second_loaded = *loaded[1].second;
+
+    CHECK( first_loaded.get_ter( { 3, 4 } ) == t_rock_wall_half );
+    CHECK( first_loaded.get_ter( { 4, 3 } ) == t_floor );
+    CHECK( first_loaded.get_furn( { 5, 6 } ) == f_chair );
+    CHECK( first_loaded.get_trap( { 7, 8 } ) == tr_bubblewrap );
+    CHECK( second_loaded.get_radiation( { SEEX - 1, SEEY - 1 } ) == 42 );
+    CHECK( first_loaded.field_count == 1 );
+    const field_entry *blood = first_loaded.get_field( { 1, 2 } ).find_field_c(
+                                   field_type_id( "fd_blood" ) );
+    REQUIRE( blood != nullptr );
+    CHECK( blood->get_field_intensity() == 2 );
+    CHECK( blood->get_field_age() == 10_turns );
+    CHECK( first_loaded.get_items( { 9, 10 } ).size() == 1 );
+    CHECK( first_loaded.get_graffiti( { 11, 0 } ) == "binary" );
+
+    // Everything, including what's not checked above, must match what the JSON format gives.
+    CHECK( stored_json( first_loaded ) == stored_json( *json_round_trip( first ) ) );
+    CHECK( stored_json( second_loaded ) == stored_json( *json_round_trip( second ) ) );
+}
+
+TEST_CASE( "submap binary rejects damaged data", "[submap]" )
+{
+    submap sm;
+    std::ostringstream os;
+    submap_binary::write_quad( os, { { tripoint_zero, &sm } } );
+    const std::string data = os.str();
+
+    std::istringstream truncated( data.substr( 0, data.size() / 2 ) );
+    CHECK_THROWS( submap_binary::read_quad( truncated ) );
+    std::istringstream not_binary( "[{\"version\":1}]" );
+    CHECK_THROWS( submap_binary::read_quad( not_binary ) );
+}
+
+TEST_CASE( "submap lists the tiles with fields", "[submap][field]" )
+{
+    submap sm;
+    const point first( 3, 5 );
+    const point second( 3, 2 );
+    const point third( 1, 9 );
+
+    sm.get_field( first ).add_field( fd_blood, 1 );
+    sm.mark_field_active( first );
+    sm.get_field( second ).add_field( fd_smoke, 1 );
+    sm.mark_field_active( second );
+    sm.mark_field_active( first );
+    CHECK( sm.get_active_fields() == std::vector<point> { first, second } );
+
+    // Emptied tiles are dropped, the rest are sorted the way the whole submap is visited.
+    sm.get_field( first ).remove_field( fd_blood );
+    sm.get_field( third ).add_field( fd_blood, 1 );
+    sm.mark_field_active( third );
+    sm.compact_active_fields();
+    CHECK( sm.get_active_fields() == std::vector<point> { third, second } );
+
+    sm.rotate( 1 );
+    const std::vector<point> &rotated = sm.get_active_fields();
+    REQUIRE( rotated.size() == 2 );
+    for( const point &p : rotated ) {
+        CHECK( sm.get_field( p ).field_count() == 1 );
+    }
+    sm.mark_field_active( rotated.front() );
+    CHECK( sm.get_active_fields().size() == 2 );
+}
+
+TEST_CASE( "saving skips map quads that did not change", "[submap][mapbuffer]" )
+{
+    // A quad within the reality bubble, so saving keeps it in the buffer
+    const tripoint om_addr = sm_to_omt_copy( get_map().get_abs_sub() );
+    const tripoint segment = omt_to_seg_copy( om_addr );
+    const std::string quad_path = string_format( "%s/maps/%d.%d.%d/%d.%d.%d",
+                                  g->get_world_base_save_path(), segment.x, segment.y, segment.z,
+                                  om_addr.x, om_addr.y, om_addr.z );
+    const auto quad_on_disk = [&]() {
+        return file_exist( quad_path + ".map" ) || file_exist( quad_path + ".bmap" );
+    };
+    const auto remove_quad = [&]() {
+        for( const std::string &path : { quad_path + ".map", quad_path + ".bmap" } ) {
+            if( file_exist( path ) ) {
+                remove_file( path );
+            }
+        }
+    };
+    remove_quad();
+
+    mapbuffer buffer;
+    const tripoint sm_addr = omt_to_sm_copy( om_addr );
+    for( const point &offset : { point_zero, point_south, point_east, point_south_east } ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->set_ter( point_zero, ter_id( 1 ) );
+        REQUIRE( buffer.add_submap( sm_addr + offset, sm ) );
+    }
+    buffer.save();
+    REQUIRE( quad_on_disk() );
+
+    // Nothing changed, so the quad isn't written again
+    remove_quad();
+    buffer.save();
+    CHECK_FALSE( quad_on_disk() );
+
+    buffer.lookup_submap( sm_addr + point_east )->set_ter( point_zero, ter_id( 2 ) );
+    buffer.save();
+    CHECK( quad_on_disk() );
+    remove_quad();
+}
@@ -0,0 +1,47 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "calendar.h"
+#include "tile_lookup_cache.h"
+
+TEST_CASE( "tile_lookup_cache_looks_up_each_index_once", "[tiles]" )
+{
+    tile_lookup_cache<std::string> cache;
+    int lookups = 0;
+    const auto lookup = [&]( const std::string & found ) {
+        return [&lookups, found]() {
+            lookups++;
+            return found;
+        };
+    };
+
+    CHECK( cache.get( SPRING, 3, lookup( "t_grass" ) ) == "t_grass" );
+    CHECK( cache.get( SPRING, 0, lookup( "t_dirt" ) ) == "t_dirt" );
+    CHECK( lookups == 2 );
+    CHECK( cache.get( SPRING, 3, lookup( "t_wrong" ) ) == "t_grass" );
+    CHECK( cache.get( SPRING, 0, lookup( "t_wrong" ) ) == "t_dirt" );
+    CHECK( lookups == 2 );
+
+    SECTION( "clearing drops the results, as loading a tileset does" ) {
+        cache.clear();
+        CHECK( cache.get( SPRING, 3, lookup( "t_grass_tall" ) ) == "t_grass_tall" );
+        CHECK( lookups == 3 );
+    }
+}
+
+TEST_CASE( "tile_lookup_cache_keeps_seasonal_variants_apart", "[tiles]" )
+{
+    tile_lookup_cache<std::string> cache;
+    const auto seasonal_tile = []( const season_type season ) {
+        return [season]() {
+            return season == WINTER ? std::string( "t_grass_season_winter" ) :
+                   std::string( "t_grass" );
+        };
+    };
+
+    CHECK( cache.get( AUTUMN, 1, seasonal_tile( AUTUMN ) ) == "t_grass" );
+    CHECK( cache.get( WINTER, 1, seasonal_tile( WINTER ) ) == "t_grass_season_winter" );
+    CHECK( cache.get( WINTER, 1, seasonal_tile( AUTUMN ) ) == "t_grass_season_winter" );
+    CHECK( cache.get( SPRING, 1, seasonal_tile( SPRING ) ) == "t_grass" );
+}
@@ -0,0 +1,67 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "json.h"
+#include "turn_profiler.h"
+
+using turn_profiler::clock_type;
+
+static const turn_profiler::phase_stats *find_stats( const std::vector<turn_profiler::phase_stats>
+        &stats, const std::string &name )
+{
+    for( const turn_profiler::phase_stats &s : stats ) {
+        if( s.name == name ) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE( "turn_profiler_collects_phase_statistics", "[turn_profiler]" )
+{
+    const turn_profiler::phase_id every_turn = turn_profiler::register_phase( "test every turn" );
+    const turn_profiler::phase_id once = turn_profiler::register_phase( "test once" );
+    CHECK( turn_profiler::register_phase( "test every turn" ) == every_turn );
+
+    turn_profiler::set_enabled( true );
+    const clock_type::time_point start = clock_type::now();
+    for( int turn = 1; turn <= 100; ++turn ) {
+        // Twice per turn, adding up to 'turn' microseconds.
+        turn_profiler::record( every_turn, start, start + std::chrono::nanoseconds( turn * 400 ) );
+        turn_profiler::record( every_turn, start, start + std::chrono::nanoseconds( turn * 600 ) );
+        if( turn == 50 ) {
+            turn_profiler::record( once, start, start + std::chrono::microseconds( 7 ) );
+        }
+        turn_profiler::end_turn();
+    }
+
+    const std::vector<turn_profiler::phase_stats> stats = turn_profiler::get_stats();
+    const turn_profiler::phase_stats *every_turn_stats = find_stats( stats, "test every turn" );
+    REQUIRE( every_turn_stats != nullptr );
+    CHECK( every_turn_stats->turns == 100 );
+    CHECK( every_turn_stats->min == Approx( 1.0 ) );
+    CHECK( every_turn_stats->avg == Approx( 50.5 ) );
+    CHECK( every_turn_stats->p99 == Approx( 99.0 ) );
+    const turn_profiler::phase_stats *once_stats = find_stats( stats, "test once" );
+    REQUIRE( once_stats != nullptr );
+    CHECK( once_stats->turns == 1 );
+    CHECK( once_stats->avg == Approx( 7.0 ) );
+
+    std::ostringstream trace;
+    turn_profiler::write_chrome_trace( trace );
+    std::istringstream trace_in( trace.str() );
+    JsonIn jsin( trace_in );
+    JsonObject jo = jsin.get_object();
+    jo.allow_omitted_members();
+    CHECK( jo.get_array( "traceEvents" ).size() == 201 );
+
+    // Re-enabling starts over.
+    turn_profiler::set_enabled( false );
+    turn_profiler::set_enabled( true );
+    CHECK( turn_profiler::get_stats().empty() );
+    turn_profiler::set_enabled( false );
+}
@@ -1,6 +1,8 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "avatar.h"
@@ -12,7 +14,10 @@
 #include "optional.h"
 #include "point.h"
 #include "type_id.h"
+#include "veh_type.h"
 #include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
 {
@@ -161,3 +166,87 @@ TEST_CASE( "vehicle_rotation_reverse" )
         }
     }
 }
+
+static std::vector<int> indices_of( const vehicle_part_with_feature_range<vpart_bitflags> &range )
+{
+    std::vector<int> result;
+    for( const vpart_reference &vp : range ) {
+        result.push_back( static_cast<int>( vp.part_index() ) );
+    }
+    return result;
+}
+
+static std::vector<int> scan_for_flag( vehicle &veh, const vpart_bitflags flag )
+{
+    std::vector<int> result;
+    for( int p = 0; p < veh.part_count(); ++p ) {
+        if( !veh.part( p ).removed && veh.part_flag( p, flag ) ) {
+            result.push_back( p );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "vehicle_feature_index_matches_part_scan" )
+{
+    clear_map();
+    vehicle *veh_ptr = get_map().add_vehicle( vproto_id( "humvee" ), tripoint( 60, 60, 0 ),
+                       0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+
+    const auto check_index = [&veh]() {
+        for( const vpart_bitflags flag : {
+                 VPFLAG_ENGINE, VPFLAG_WHEEL, VPFLAG_CARGO, VPFLAG_OBSTACLE, VPFLAG_BOARDABLE
+             } ) {
+            CAPTURE( static_cast<int>( flag ) );
+            CHECK( indices_of( veh.get_any_parts( flag ) ) == scan_for_flag( veh, flag ) );
+        }
+        for( int p = 0; p < veh.part_count(); ++p ) {
+            const point mount = veh.part( p ).mount;
+            int first_obstacle = -1;
+            for( const int i : veh.parts_at_relative( mount, false ) ) {
+                if( veh.part_flag( i, "OBSTACLE" ) ) {
+                    first_obstacle = i;
+                    break;
+                }
+            }
+            CHECK( veh.part_with_feature( mount, "OBSTACLE", false ) == first_obstacle );
+            std::vector<int> cached = veh.parts_at_relative( mount, true );
+            std::sort( cached.begin(), cached.end() );
+            CHECK( cached == veh.parts_at_relative( mount, false ) );
+        }
+    };
+
+    REQUIRE_FALSE( scan_for_flag( veh, VPFLAG_WHEEL ).empty() );
+    check_index();
+
+    WHEN( "a wheel is removed" ) {
+        REQUIRE( veh.remove_part( scan_for_flag( veh, VPFLAG_WHEEL ).front() ) );
+        THEN( "the indices skip it" ) {
+            check_index();
+        }
+        veh.part_removal_cleanup();
+        THEN( "the indices follow the erased part" ) {
+            check_index();
+        }
+    }
+}
+
+TEST_CASE( "vehicle_cache_counts_occupied_tiles" )
+{
+    clear_map();
+    map &here = get_map();
+    const level_cache &cache = here.get_cache_ref( 0 );
+    REQUIRE( cache.veh_exists_count == 0 );
+
+    vehicle *veh_ptr = here.add_vehicle( vproto_id( "humvee" ), tripoint( 60, 60, 0 ), 0_degrees,
+                                         0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    const std::set<tripoint> &points = veh_ptr->get_points( true );
+    CHECK( cache.veh_exists_count == static_cast<int>( points.size() ) );
+    CHECK( cache.veh_in_active_range );
+
+    here.destroy_vehicle( veh_ptr );
+    CHECK( cache.veh_exists_count == 0 );
+}
@@ -703,3 +703,38 @@ TEST_CASE( "vision_see_into_vehicle", "[shadowcasting][vision]" )
 
     t.test();
 }
+
+TEST_CASE( "lightmap_follows_changing_light_sources", "[shadowcasting][vision]" )
+{
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+
+    clear_map_and_put_player_underground();
+    set_time( midnight );
+    map &here = get_map();
+    const tripoint lamp( 60, 60, 0 );
+    const tripoint lit_tile = lamp + tripoint( 3, 0, 0 );
+    here.build_map_cache( lamp.z );
+    const float dark = here.ambient_light_at( lit_tile );
+
+    here.ter_set( lamp, t_utility_light );
+    here.build_map_cache( lamp.z );
+    const float lit = here.ambient_light_at( lit_tile );
+    CHECK( lit > dark );
+
+    // The same light is cast when nothing changed.
+    here.build_map_cache( lamp.z );
+    CHECK( here.ambient_light_at( lit_tile ) == lit );
+
+    // A new wall casts a shadow.
+    here.ter_set( lamp + tripoint_east, t_brick_wall );
+    here.build_map_cache( lamp.z );
+    CHECK( here.ambient_light_at( lit_tile ) < lit );
+
+    // And once both are gone, no light stays behind.
+    here.ter_set( lamp + tripoint_east, t_floor );
+    here.ter_set( lamp, t_floor );
+    here.build_map_cache( lamp.z );
+    CHECK( here.ambient_light_at( lit_tile ) == dark );
+}